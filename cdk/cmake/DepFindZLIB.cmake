@@ -0,0 +1,61 @@
+# Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+#
+# This program is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License, version 2.0, as
+# published by the Free Software Foundation.
+#
+# This program is also distributed with certain software (including
+# but not limited to OpenSSL) that is licensed under separate terms,
+# as designated in a particular file or component or in included license
+# documentation.  The authors of MySQL hereby grant you an
+# additional permission to link the program and your derivative works
+# with the separately licensed software that they have included with
+# MySQL.
+#
+# Without limiting anything contained in the foregoing, this file,
+# which is part of MySQL Connector/C++, is also subject to the
+# Universal FOSS Exception, version 1.0, a copy of which can be found at
+# http://oss.oracle.com/licenses/universal-foss-exception.
+#
+# This program is distributed in the hope that it will be useful, but
+# WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+# See the GNU General Public License, version 2.0, for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program; if not, write to the Free Software Foundation, Inc.,
+# 51 Franklin St, Fifth Floor, Boston, MA 02110-1301  USA
+##############################################################################
+#
+# Targets:
+#   ZLIB::zlib - zlib library used for X Protocol compression
+#
+# If zlib is not found, the target is not defined and HAVE_ZLIB is not set
+# in the configuration header. In that case compression is not available.
+#
+
+if(TARGET ZLIB::zlib)
+  return()
+endif()
+
+message(STATUS "Looking for zlib library.")
+
+find_path(ZLIB_INCLUDE_DIR NAMES zlib.h)
+find_library(ZLIB_LIBRARY NAMES z zlib zlib1)
+
+if(NOT ZLIB_INCLUDE_DIR OR NOT ZLIB_LIBRARY)
+  message(STATUS "zlib not found, X Protocol compression will not be available.")
+  return()
+endif()
+
+message("-- zlib library: ${ZLIB_LIBRARY}")
+
+add_library(ZLIB::zlib SHARED IMPORTED GLOBAL)
+set_target_properties(ZLIB::zlib PROPERTIES
+  IMPORTED_LOCATION "${ZLIB_LIBRARY}"
+  IMPORTED_IMPLIB "${ZLIB_LIBRARY}"
+  INTERFACE_INCLUDE_DIRECTORIES "${ZLIB_INCLUDE_DIR}"
+)
+
+add_config(HAVE_ZLIB)
+set(HAVE_ZLIB 1 CACHE INTERNAL "zlib is available")
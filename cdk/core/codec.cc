@@ -33,8 +33,9 @@
 #include "../parser/json_parser.h"
 
 PUSH_SYS_WARNINGS_CDK
-#include <sstream>
 #include <algorithm>  // std::min
+#include <clocale>    // localeconv()
+#include <limits>
 POP_SYS_WARNINGS_CDK
 
 // Include Protobuf headers needed for decoding float numbers
@@ -376,14 +377,25 @@ size_t Codec<TYPE_INTEGER>::to_bytes(uint64_t val, bytes buf)
   return internal_to_bytes(val, buf);
 }
 
-std::string Codec<TYPE_FLOAT>::internal_decimal_to_string(bytes buf)
+/*
+  DECIMAL values are encoded as packed BCD: the first byte gives the scale,
+  then follow the digits, two per byte, and a sign nibble which is 0xC for
+  positive and 0xD for negative value. If the number of digits is odd, the
+  last digit shares its byte with the sign nibble.
+*/
+
+size_t Codec<TYPE_FLOAT>::from_bytes(bytes buf, Decimal &val)
 {
+  if (m_fmt.type() != cdk::Format<cdk::TYPE_FLOAT>::DECIMAL)
+    throw Error(cdkerrc::conversion_error,
+                "Codec<TYPE_FLOAT>: not a DECIMAL value");
+
   if (buf.size() < 2)
     THROW("Invalid DECIMAL buffer");
+
   byte scale_digits = *buf.begin();
   byte sign_byte = *(buf.end() - 1);
-  int last_digit = -1;
-  bool is_negative;
+  bool has_last_digit;
 
   /*
     Last 4 bits of DECIMAL should always be 1100 (0xC) for positive
@@ -392,47 +404,106 @@ std::string Codec<TYPE_FLOAT>::internal_decimal_to_string(bytes buf)
   if ((sign_byte & 0x0C) == 0x0C)
   {
     /* A digit must be retrieved from the first 4 bits of the sign byte */
-    last_digit = (int)(sign_byte >> 4);
-    is_negative = (sign_byte & 0x0D) == 0x0D;
+    has_last_digit = true;
+    val.negative = (sign_byte & 0x0D) == 0x0D;
   }
   else if ((sign_byte & 0xC0) == 0xC0)
   {
     /* No digit in the sign byte */
-    is_negative = (sign_byte & 0xD0) == 0xD0;
+    has_last_digit = false;
+    val.negative = (sign_byte & 0xD0) == 0xD0;
   }
   else
     THROW("Invalid DECIMAL buffer");
 
-  int total_digits = ((int)buf.size() - 2) * 2 + (last_digit + 1 ? 1 : 0);
-  if (total_digits <= scale_digits)
+  size_t total_digits = (buf.size() - 2) * 2 + (has_last_digit ? 1 : 0);
+  if (total_digits <= scale_digits || scale_digits > Decimal::max_digits)
     THROW("Invalid DECIMAL buffer");
 
-  std::stringstream sstream;
+  val.scale = scale_digits;
+  val.digit_count = 0;
+
+  for (size_t pos = 0; pos < total_digits; ++pos)
+  {
+    byte b = *(buf.begin() + 1 + pos / 2);
+    byte digit = (pos % 2) ? (b & 0x0F) : (b >> 4);
+
+    if (digit > 9)
+      THROW("Invalid DECIMAL buffer");
+
+    // Skip leading zeros, but keep at least one digit before decimal point.
+
+    if (0 == val.digit_count && 0 == digit
+        && total_digits - pos > scale_digits + 1U)
+      continue;
+
+    if (val.digit_count == Decimal::max_digits)
+      THROW("Invalid DECIMAL buffer");
+
+    val.digits[val.digit_count++] = digit;
+  }
+
+  return buf.size();
+}
+
+
+/*
+  Write textual representation of a DECIMAL value into the given buffer,
+  using the decimal point of the current C locale so that the result can be
+  parsed with strtod() and friends.
+*/
+
+static
+void decimal_to_chars(const Decimal &val, char (&out)[Decimal::max_digits + 4])
+{
+  char *pos = out;
 
-  if (is_negative)
-    sstream << "-";
+  if (val.negative)
+    *pos++ = '-';
 
-  int pos = 0;
-  for (byte *b = buf.begin() + 1; b < buf.end() - 1; ++b)
+  for (unsigned i = 0; i < val.digit_count; ++i)
   {
-    do
-    {
-      if (total_digits - scale_digits == pos)
-        /* Getting the locale decimal point */
-        sstream << std::use_facet< std::numpunct<char> >(sstream.getloc()).decimal_point();;
-
-      if (pos % 2)
-        sstream << (int)(*b & 0x0F);
-      else
-        sstream << (int)(*b >> 4);
-      ++pos;
-    } while (pos % 2);
+    if (i + val.scale == val.digit_count)
+      *pos++ = *localeconv()->decimal_point;
+    *pos++ = (char)('0' + val.digits[i]);
   }
 
-  if (last_digit + 1)
-    sstream << last_digit;
+  *pos = '\0';
+}
+
 
-  return sstream.str();
+/*
+  If all digits of a DECIMAL value fit into an integer that is exactly
+  represented by a floating point type T, and so does the power of 10 given
+  by the scale, then dividing the two gives correctly rounded result. This
+  fast path avoids textual conversion for most values. Returns false if
+  the fast path can not be used.
+*/
+
+template <typename T>
+static
+bool decimal_to_float(const Decimal &val, T &out)
+{
+  static const unsigned max_digits = std::numeric_limits<T>::digits10;
+  static const unsigned max_scale
+    = std::numeric_limits<T>::digits == 24 ? 10 : 22;
+
+  if (val.digit_count > max_digits || val.scale > max_scale)
+    return false;
+
+  uint64_t mantissa = 0;
+  for (unsigned i = 0; i < val.digit_count; ++i)
+    mantissa = mantissa * 10 + val.digits[i];
+
+  T divisor = 1;
+  for (unsigned i = 0; i < val.scale; ++i)
+    divisor *= 10;
+
+  out = static_cast<T>(mantissa) / divisor;
+  if (val.negative)
+    out = -out;
+
+  return true;
 }
 
 
@@ -440,12 +511,20 @@ size_t Codec<TYPE_FLOAT>::from_bytes(bytes buf, float &val)
 {
   if (m_fmt.type() == cdk::Format<cdk::TYPE_FLOAT>::DECIMAL)
   {
-    std::string s = internal_decimal_to_string(buf);
-    const char *data = s.c_str();
+    Decimal dec;
+    from_bytes(buf, dec);
+
+    if (decimal_to_float(dec, val))
+      return buf.size();
+
+    char data[Decimal::max_digits + 4];
+    decimal_to_chars(dec, data);
     char *str_end;
     float f = strtof(data, &str_end);
 
-    if (*str_end != '\0' || f == std::numeric_limits<float>::infinity())
+    if (*str_end != '\0'
+        || f == std::numeric_limits<float>::infinity()
+        || f == -std::numeric_limits<float>::infinity())
       THROW("Codec<TYPE_FLOAT>: conversion overflow");
     val = f;
     return buf.size();
@@ -472,8 +551,14 @@ size_t Codec<TYPE_FLOAT>::from_bytes(bytes buf, double &val)
 {
   if (m_fmt.type() == cdk::Format<cdk::TYPE_FLOAT>::DECIMAL)
   {
-    std::string s = internal_decimal_to_string(buf);
-    const char *data = s.c_str();
+    Decimal dec;
+    from_bytes(buf, dec);
+
+    if (decimal_to_float(dec, val))
+      return buf.size();
+
+    char data[Decimal::max_digits + 4];
+    decimal_to_chars(dec, data);
     char *str_end;
     double d = strtod(data, &str_end);
 
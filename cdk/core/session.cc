@@ -31,6 +31,7 @@
 
 #include <mysql/cdk/session.h>
 #include <mysql/cdk/mysqlx/session.h>
+#include <mysql/cdk/foundation/endpoint_health.h>
 
 
 namespace cdk {
@@ -50,13 +51,21 @@ struct Session_builder
   using TCPIP = cdk::connection::TCPIP;
   using Socket_base = foundation::connection::Socket_base;
 
-  unique_ptr<cdk::api::Connection> m_conn;
+  unique_ptr<Socket_base> m_conn;
   mysqlx::Session      *m_sess = NULL;
   const mysqlx::string *m_database = NULL;
   bool m_throw_errors = false;
   scoped_ptr<Error>     m_error;
   unsigned              m_attempts = 0;
 
+  /*
+    Decides which endpoints are tried when connecting to a Multi_source
+    (see Endpoint_health). Other data sources are always tried.
+  */
+
+  foundation::Endpoint_selector m_selector;
+  bool                  m_multi_source = false;
+
   Session_builder(bool throw_errors = false)
     : m_throw_errors(throw_errors)
   {}
@@ -89,7 +98,14 @@ struct Session_builder
   */
 
   template <class Conn>
-  bool connect(Conn&);
+  bool connect(Conn&, const std::string &endpoint);
+
+  /*
+    Returns true if connection attempt to the given endpoint should not be
+    made now.
+  */
+
+  bool skip(const std::string &endpoint);
 
 #ifdef WITH_SSL
 
@@ -115,18 +131,27 @@ struct Session_builder
 };
 
 
+bool Session_builder::skip(const std::string &endpoint)
+{
+  return m_multi_source && m_selector.skip(endpoint);
+}
+
+
 template <class Conn>
-bool Session_builder::connect(Conn &connection)
+bool Session_builder::connect(Conn &connection, const std::string &endpoint)
 {
   m_attempts++;
 
   try
   {
     connection.connect();
+    foundation::Endpoint_health::instance().report(endpoint, true);
     return true;
   }
   catch (...)
   {
+    foundation::Endpoint_health::instance().report(endpoint, false);
+
     // Use rethrow_error() to wrap arbitrary exception in cdk::Error.
 
     try {
@@ -159,10 +184,15 @@ Session_builder::operator() (
   using foundation::connection::TCPIP;
   using foundation::connection::Socket_base;
 
+  std::string endpoint = ds.host() + ":" + std::to_string(ds.port());
+
+  if (skip(endpoint))
+    return false;
+
   unique_ptr<TCPIP> connection(new TCPIP(ds.host(), ds.port(),
                                options));
 
-  if (!connect(*connection))
+  if (!connect(*connection, endpoint))
     return false;  // continue to next host if available
 
 #ifdef WITH_SSL
@@ -226,9 +256,12 @@ Session_builder::operator() (
   using foundation::connection::Unix_socket;
   using foundation::connection::Socket_base;
 
+  if (skip(ds.path()))
+    return false;
+
   unique_ptr<Unix_socket> connection(new Unix_socket(ds.path(), options));
 
-  if (!connect(*connection))
+  if (!connect(*connection, ds.path()))
     return false;  // continue to next host if available
 
   m_sess = new mysqlx::Session(*connection, options);
@@ -389,8 +422,17 @@ Session::Session(ds::Multi_source &ds)
 {
   Session_builder sb;
 
+  /*
+    First try endpoints which are not known to be failing. If none of them
+    works, try the ones that were skipped.
+  */
+
+  sb.m_multi_source = true;
   ds::Multi_source::Access::visit(ds, sb);
 
+  if (!sb.m_sess && sb.m_selector.next_pass())
+    ds::Multi_source::Access::visit(ds, sb);
+
   if (!sb.m_sess)
   {
     if (1 == sb.m_attempts && sb.m_error)
@@ -37,7 +37,12 @@ PUSH_SYS_WARNINGS_CDK
 #include <openssl/x509v3.h>
 #include <openssl/err.h>
 #include <iostream>
+#include <list>
 #include <map>
+#include <mutex>
+#include <sstream>
+#include <sys/types.h>
+#include <sys/stat.h>
 POP_SYS_WARNINGS_CDK
 #include <mysql/cdk/foundation/error.h>
 #include <mysql/cdk/foundation/connection_openssl.h>
@@ -201,9 +206,17 @@ static void throw_openssl_error()
   It will get ssl error and throw it if needed.
   Will return normally if the error can be continued.
 */
-static void throw_ssl_error(SSL* tls, int err)
+/*
+  Throw error reported by failed TLS operation. If the operation should be
+  retried when the socket is ready, no error is thrown and the OpenSSL error
+  code (such as SSL_ERROR_WANT_READ) is returned.
+*/
+
+static int throw_ssl_error(SSL* tls, int err)
 {
-  switch(SSL_get_error(tls, err))
+  int code = SSL_get_error(tls, err);
+
+  switch(code)
   {
   case SSL_ERROR_WANT_READ:
   case SSL_ERROR_WANT_WRITE:
@@ -217,7 +230,7 @@ static void throw_ssl_error(SSL* tls, int err)
 # endif
 #endif
     //Will not throw anything, so function that calls this, will continue.
-    break;
+    return code;
   case SSL_ERROR_ZERO_RETURN:
     throw connection::Error_eos();
   case SSL_ERROR_SYSCALL:
@@ -227,10 +240,35 @@ static void throw_ssl_error(SSL* tls, int err)
   default:
     {
       char buffer[512];
-      ERR_error_string_n(static_cast<unsigned long>(SSL_get_error(tls, err)), buffer, sizeof(buffer));
+      ERR_error_string_n(static_cast<unsigned long>(code), buffer, sizeof(buffer));
       throw_openssl_error_msg(buffer);
     }
   }
+  return code;
+}
+
+
+/*
+  Called after TLS operation on the non-blocking socket could not proceed
+  (with OpenSSL error code as returned by throw_ssl_error()). If caller
+  wants to wait, waits until the socket is ready for the I/O requested by
+  OpenSSL.
+*/
+
+static void ssl_wait(connection::Socket_base &tcpip, int code, bool wait)
+{
+  namespace detail = cdk::foundation::connection::detail;
+
+  if (!wait)
+    return;
+
+  if (0 > detail::poll_one(
+        static_cast<detail::Socket>(tcpip.get_fd()),
+        SSL_ERROR_WANT_WRITE == code
+          ? detail::POLL_MODE_WRITE : detail::POLL_MODE_READ,
+        true
+      ))
+    cdk::foundation::throw_posix_error();
 }
 
 
@@ -280,8 +318,7 @@ public:
       SSL_free(m_tls);
     }
 
-    if (m_tls_ctx)
-      SSL_CTX_free(m_tls_ctx);
+    // Note: m_tls_ctx is referenced by m_tls and released together with it.
 
     delete m_tcpip;
   }
@@ -294,6 +331,10 @@ public:
   SSL* m_tls;
   SSL_CTX* m_tls_ctx;
   connection::TLS::Options m_options;
+
+  // Key under which TLS session for this connection is cached.
+
+  std::string m_session_key;
 };
 
 
@@ -553,50 +594,220 @@ void TLS_helper::set_ciphers(const Ciphers_list &list)
 }
 
 
-void connection_TLS_impl::do_connect()
+/*
+  Process-wide cache of TLS contexts and client TLS sessions.
+
+  Creating a TLS context involves processing of version and cipher lists
+  and loading of CA certificates, which is costly. Contexts are created
+  once for each distinct TLS configuration and then shared by all
+  connections using this configuration.
+
+  TLS sessions established with a server are stored per server endpoint
+  (and TLS configuration) so that later connections to the same endpoint
+  can resume them with an abbreviated handshake.
+
+  Both caches are bounded and the least recently used entries are evicted
+  when they grow too big. A context evicted from the cache stays alive as
+  long as it is used by some TLS connection (OpenSSL keeps reference count
+  of contexts). The cache key of a context includes modification times of
+  the CA file and CA directory, so that a new context is created (and new
+  certificates are loaded) if these are changed.
+
+  Note: The cache instance itself is kept until the process exits. It is
+  not destroyed as a static object because at that time OpenSSL might be
+  already de-initialized.
+*/
+
+class TLS_cache
 {
-  if (m_tcpip->is_closed())
-    m_tcpip->connect();
+public:
 
-  if (m_tls || m_tls_ctx)
+  static TLS_cache& get()
   {
-    // TLS handshake already established, exit.
-    return;
+    static TLS_cache *instance = new TLS_cache();
+    return *instance;
   }
 
-  try
+  /*
+    Create new TLS connection object using context for the given options,
+    which is created if needed. The key under which the context is cached is
+    returned in the key argument.
+  */
+
+  SSL* new_tls(connection::TLS::Options&, std::string &key);
+
+  void set_session(SSL*, const std::string &key);
+
+  static int new_session(SSL*, SSL_SESSION*);
+
+private:
+
+  static SSL_CTX* create_ctx(connection::TLS::Options&);
+
+  /*
+    Map with limited size which frees the least recently used entries
+    when new ones are added to a full map.
+  */
+
+  template <typename T, void (*Free)(T*), size_t max_size>
+  class LRU_map
   {
-    const SSL_METHOD* method = SSLv23_client_method();
+    using Key_list = std::list<std::string>;
+    using Entry = std::pair<T*, Key_list::iterator>;
 
-    if (!method)
-      throw_openssl_error();
+    Key_list m_lru;   // the most recently used key first
+    std::map<std::string, Entry> m_map;
 
-    m_tls_ctx = SSL_CTX_new(method);
-    if (!m_tls_ctx)
-      throw_openssl_error();
+  public:
+
+    ~LRU_map()
+    {
+      for (auto &el : m_map)
+        Free(el.second.first);
+    }
+
+    T* find(const std::string &key)
+    {
+      auto it = m_map.find(key);
+      if (it == m_map.end())
+        return nullptr;
+      m_lru.splice(m_lru.begin(), m_lru, it->second.second);
+      return it->second.first;
+    }
+
+    // Takes ownership of the value, replacing previous one, if any.
+
+    void set(const std::string &key, T *val)
+    {
+      auto it = m_map.find(key);
+
+      if (it != m_map.end())
+      {
+        Free(it->second.first);
+        it->second.first = val;
+        m_lru.splice(m_lru.begin(), m_lru, it->second.second);
+        return;
+      }
+
+      if (m_map.size() >= max_size)
+      {
+        auto last = m_map.find(m_lru.back());
+        Free(last->second.first);
+        m_map.erase(last);
+        m_lru.pop_back();
+      }
+
+      m_lru.push_front(key);
+      m_map.emplace(key, Entry(val, m_lru.begin()));
+    }
+  };
+
+  std::mutex m_mutex;
+  LRU_map<SSL_CTX, SSL_CTX_free, 16> m_ctx;
+  LRU_map<SSL_SESSION, SSL_SESSION_free, 256> m_sessions;
+};
+
+
+/*
+  Return modification time of the given file or directory, or 0 if it can
+  not be determined.
+*/
+
+static ::time_t file_mtime(const std::string &path)
+{
+  struct stat info;
+
+  if (path.empty() || 0 != stat(path.c_str(), &info))
+    return 0;
+
+  return info.st_mtime;
+}
+
+
+SSL* TLS_cache::new_tls(
+  connection::TLS::Options &options, std::string &key
+)
+{
+  std::ostringstream buf;
+
+  if (
+    options.ssl_mode()
+    >=
+    cdk::foundation::connection::TLS::Options::SSL_MODE::VERIFY_CA
+  )
+    buf << "verify" << '\0'
+        << options.get_ca() << '\0' << file_mtime(options.get_ca()) << '\0'
+        << options.get_ca_path() << '\0' << file_mtime(options.get_ca_path())
+        << '\0';
+
+  for (const auto &ver : options.get_tls_versions())
+    buf << ver.m_major << "." << ver.m_minor << ",";
+  buf << '\0';
+
+  for (const auto &cipher : options.get_ciphersuites())
+    buf << cipher << ",";
+
+  key = buf.str();
+
+  /*
+    Note: TLS connection object is created while holding the lock, so that
+    the context can not be evicted and freed before the connection takes
+    its reference to it.
+  */
+
+  std::lock_guard<std::mutex> guard(m_mutex);
+
+  SSL_CTX *ctx = m_ctx.find(key);
+
+  if (!ctx)
+  {
+    ctx = create_ctx(options);
+    m_ctx.set(key, ctx);
+  }
+
+  SSL *tls = SSL_new(ctx);
+  if (!tls)
+    throw_openssl_error();
+
+  return tls;
+}
 
+
+SSL_CTX* TLS_cache::create_ctx(connection::TLS::Options &options)
+{
+  const SSL_METHOD* method = SSLv23_client_method();
+
+  if (!method)
+    throw_openssl_error();
+
+  SSL_CTX *ctx = SSL_CTX_new(method);
+  if (!ctx)
+    throw_openssl_error();
+
+  try
+  {
     // Set allowed TLS protocol versions and ciphers
 
     {
       // Note: copy defaults from static instance
       TLS_helper helper(TLS_helper::m_instance);
 
-      auto vlist = m_options.get_tls_versions();
+      auto vlist = options.get_tls_versions();
       if (!vlist.empty())
         helper.set_versions(vlist);
 
-      auto clist = m_options.get_ciphersuites();
+      auto clist = options.get_ciphersuites();
       if (!clist.empty())
         helper.set_ciphers(clist);
 
-      helper.setup(m_tls_ctx);
+      helper.setup(ctx);
     }
 
 
     // Certificate data, if requested.
 
     if (
-      m_options.ssl_mode()
+      options.ssl_mode()
       >=
       cdk::foundation::connection::TLS::Options::SSL_MODE::VERIFY_CA
     )
@@ -605,25 +816,96 @@ void connection_TLS_impl::do_connect()
         Warnings must be disabled because of a bug in Visual Studio 2017 compiler:
         https://developercommunity.visualstudio.com/content/problem/130244/c-warning-c5039-reported-for-nullptr-argument.html
       */
-      SSL_CTX_set_verify(m_tls_ctx, SSL_VERIFY_PEER, nullptr);
+      SSL_CTX_set_verify(ctx, SSL_VERIFY_PEER, nullptr);
 
       if (SSL_CTX_load_verify_locations(
-            m_tls_ctx,
-            m_options.get_ca().c_str(),
-            m_options.get_ca_path().empty()
-            ? NULL : m_options.get_ca_path().c_str()) == 0)
+            ctx,
+            options.get_ca().c_str(),
+            options.get_ca_path().empty()
+            ? NULL : options.get_ca_path().c_str()) == 0)
         throw_openssl_error();
     }
     else
     {
-      SSL_CTX_set_verify(m_tls_ctx, SSL_VERIFY_NONE, nullptr);
+      SSL_CTX_set_verify(ctx, SSL_VERIFY_NONE, nullptr);
     }
 
+    /*
+      New client sessions are reported to new_session() callback which
+      stores them in this cache (OpenSSL does not keep client sessions).
+    */
+
+    SSL_CTX_set_session_cache_mode(
+      ctx, SSL_SESS_CACHE_CLIENT | SSL_SESS_CACHE_NO_INTERNAL_STORE
+    );
+    SSL_CTX_sess_set_new_cb(ctx, &TLS_cache::new_session);
+  }
+  catch (...)
+  {
+    SSL_CTX_free(ctx);
+    throw;
+  }
+
+  return ctx;
+}
+
+
+/*
+  Set TLS session stored under the given key, if any, to be resumed
+  by the given TLS connection.
+*/
+
+void TLS_cache::set_session(SSL *tls, const std::string &key)
+{
+  std::lock_guard<std::mutex> guard(m_mutex);
+
+  SSL_SESSION *sess = m_sessions.find(key);
+  if (sess)
+    SSL_set_session(tls, sess);
+}
+
+
+/*
+  Callback called by OpenSSL when a new session is established (for TLSv1.3
+  this happens when session ticket is received after the handshake). Takes
+  ownership of the session object.
+*/
+
+int TLS_cache::new_session(SSL *tls, SSL_SESSION *sess)
+{
+  auto *impl = static_cast<connection_TLS_impl*>(SSL_get_app_data(tls));
+
+  if (!impl || impl->m_session_key.empty())
+    return 0;
+
+  TLS_cache &cache = get();
+  std::lock_guard<std::mutex> guard(cache.m_mutex);
+
+  cache.m_sessions.set(impl->m_session_key, sess);
+
+  return 1;
+}
+
+
+void connection_TLS_impl::do_connect()
+{
+  if (m_tcpip->is_closed())
+    m_tcpip->connect();
+
+  if (m_tls || m_tls_ctx)
+  {
+    // TLS handshake already established, exit.
+    return;
+  }
+
+  try
+  {
+    std::string ctx_key;
+
     // Establish TLS connection
 
-    m_tls = SSL_new(m_tls_ctx);
-    if (!m_tls)
-      throw_openssl_error();
+    m_tls = TLS_cache::get().new_tls(m_options, ctx_key);
+    m_tls_ctx = SSL_get_SSL_CTX(m_tls);
 
     unsigned int fd = m_tcpip->get_fd();
 
@@ -631,6 +913,22 @@ void connection_TLS_impl::do_connect()
 
     SSL_set_fd(m_tls, static_cast<int>(fd));
 
+    /*
+      Resume TLS session previously established with the same server, if
+      any. Sessions are cached per server address, TLS configuration and
+      host name used for certificate verification.
+    */
+
+    std::string peer
+      = cdk::foundation::connection::detail::get_peer_address(fd);
+
+    if (!peer.empty())
+    {
+      m_session_key = ctx_key + '\0' + m_options.get_host_name() + '\0' + peer;
+      SSL_set_app_data(m_tls, this);
+      TLS_cache::get().set_session(m_tls, m_session_key);
+    }
+
 #ifdef HAVE_REQUIRED_X509_FUNCTIONS
     /*
       The new way of server certificate verification
@@ -643,6 +941,14 @@ void connection_TLS_impl::do_connect()
     if(SSL_connect(m_tls) != 1)
       throw_openssl_error();
 
+    /*
+      Handshake is done in blocking mode. After that the socket is switched
+      back to non-blocking mode and TLS I/O operations wait for the socket
+      only when OpenSSL reports that they can not proceed (see ssl_wait()).
+    */
+
+    cdk::foundation::connection::detail::set_nonblocking(fd, true);
+
 #ifndef HAVE_REQUIRED_X509_FUNCTIONS
     /*
       The old way of server certificate verification
@@ -663,11 +969,7 @@ void connection_TLS_impl::do_connect()
       m_tls = NULL;
     }
 
-    if (m_tls_ctx)
-    {
-      SSL_CTX_free(m_tls_ctx);
-      m_tls_ctx = NULL;
-    }
+    m_tls_ctx = NULL;
 
     throw;
   }
@@ -882,6 +1184,12 @@ Socket_base::Impl& TLS::get_base_impl()
 }
 
 
+unsigned int TLS::get_fd() const
+{
+  return get_impl().m_tcpip->get_fd();
+}
+
+
 TLS::Read_op::Read_op(TLS &conn, const buffers &bufs, time_t deadline)
   : IO_op(conn, bufs, deadline)
   , m_tls(conn)
@@ -897,18 +1205,18 @@ TLS::Read_op::Read_op(TLS &conn, const buffers &bufs, time_t deadline)
 
 bool TLS::Read_op::do_cont()
 {
-  return common_read();
+  return common_read(false);
 }
 
 
 void TLS::Read_op::do_wait()
 {
   while (!is_completed())
-    common_read();
+    common_read(true);
 }
 
 
-bool TLS::Read_op::common_read()
+bool TLS::Read_op::common_read(bool wait)
 {
   if (is_completed())
     return true;
@@ -923,7 +1231,8 @@ bool TLS::Read_op::common_read()
 
   if (result <= 0)
   {
-    throw_ssl_error(impl.m_tls, result);
+    ssl_wait(*impl.m_tcpip, throw_ssl_error(impl.m_tls, result), wait);
+    return false;
   }
 
   if (result > 0)
@@ -933,6 +1242,7 @@ bool TLS::Read_op::common_read()
     if (m_currentBufferOffset == buffer.size())
     {
       ++m_currentBufferIdx;
+      m_currentBufferOffset = 0;
 
       if (m_currentBufferIdx == m_bufs.buf_count())
       {
@@ -959,18 +1269,29 @@ TLS::Read_some_op::Read_some_op(TLS &conn, const buffers &bufs, time_t deadline)
 
 bool TLS::Read_some_op::do_cont()
 {
-  return common_read();
+  if (is_completed())
+    return true;
+
+  /*
+    If no data is available, complete with 0 bytes read, as non-blocking
+    socket read would do.
+  */
+
+  if (!common_read(false))
+    set_completed(0);
+
+  return true;
 }
 
 
 void TLS::Read_some_op::do_wait()
 {
   while (!is_completed())
-    common_read();
+    common_read(true);
 }
 
 
-bool TLS::Read_some_op::common_read()
+bool TLS::Read_some_op::common_read(bool wait)
 {
   if (is_completed())
     return true;
@@ -983,7 +1304,8 @@ bool TLS::Read_some_op::common_read()
 
   if (result <= 0)
   {
-    throw_ssl_error(impl.m_tls, result);
+    ssl_wait(*impl.m_tcpip, throw_ssl_error(impl.m_tls, result), wait);
+    return false;
   }
 
   if (result > 0)
@@ -1006,30 +1328,48 @@ TLS::Write_op::Write_op(TLS &conn, const buffers &bufs, time_t deadline)
 
   if (!impl.m_tcpip->get_base_impl().is_open())
     throw Error_no_connection();
+
+  /*
+    Data from several buffers is first copied into a single one so that it
+    is written with one SSL_write() call and goes out in as few TLS records
+    (and socket writes) as possible.
+  */
+
+  if (bufs.buf_count() > 1)
+  {
+    m_coalesced.reserve(bufs.length());
+    for (unsigned int i = 0; i < bufs.buf_count(); ++i)
+    {
+      bytes buf = bufs.get_buffer(i);
+      m_coalesced.insert(m_coalesced.end(), buf.begin(), buf.end());
+    }
+  }
 }
 
 
 bool TLS::Write_op::do_cont()
 {
-  return common_write();
+  return common_write(false);
 }
 
 
 void TLS::Write_op::do_wait()
 {
   while (!is_completed())
-    common_write();
+    common_write(true);
 }
 
 
-bool TLS::Write_op::common_write()
+bool TLS::Write_op::common_write(bool wait)
 {
   if (is_completed())
     return true;
 
   connection_TLS_impl& impl = m_tls.get_impl();
 
-  const bytes& buffer = m_bufs.get_buffer(m_currentBufferIdx);
+  const bytes buffer = m_coalesced.empty()
+    ? m_bufs.get_buffer(m_currentBufferIdx)
+    : bytes(m_coalesced.data(), m_coalesced.size());
   byte* data = buffer.begin() + m_currentBufferOffset;
   int buffer_size = static_cast<int>(buffer.size() - m_currentBufferOffset);
 
@@ -1037,7 +1377,8 @@ bool TLS::Write_op::common_write()
 
   if (result <= 0)
   {
-    throw_ssl_error(impl.m_tls, result);
+    ssl_wait(*impl.m_tcpip, throw_ssl_error(impl.m_tls, result), wait);
+    return false;
   }
 
   if (result > 0)
@@ -1046,7 +1387,12 @@ bool TLS::Write_op::common_write()
 
     if (m_currentBufferOffset == buffer.size())
     {
-      ++m_currentBufferIdx;
+      m_currentBufferOffset = 0;
+
+      if (m_coalesced.empty())
+        ++m_currentBufferIdx;
+      else
+        m_currentBufferIdx = m_bufs.buf_count();
 
       if (m_currentBufferIdx == m_bufs.buf_count())
       {
@@ -1073,18 +1419,18 @@ TLS::Write_some_op::Write_some_op(TLS &conn, const buffers &bufs, time_t deadlin
 
 bool TLS::Write_some_op::do_cont()
 {
-  return common_write();
+  return common_write(false);
 }
 
 
 void TLS::Write_some_op::do_wait()
 {
   while (!is_completed())
-    common_write();
+    common_write(true);
 }
 
 
-bool TLS::Write_some_op::common_write()
+bool TLS::Write_some_op::common_write(bool wait)
 {
   if (is_completed())
     return true;
@@ -1097,7 +1443,8 @@ bool TLS::Write_some_op::common_write()
 
   if (result <= 0)
   {
-    throw_ssl_error(impl.m_tls, result);
+    ssl_wait(*impl.m_tcpip, throw_ssl_error(impl.m_tls, result), wait);
+    return false;
   }
 
   if (result > 0)
@@ -238,6 +238,34 @@ Socket_base::Read_op::Read_op(Socket_base &conn, const buffers &bufs, time_t dea
 }
 
 
+/*
+  Move position (idx, offset) within the list of buffers by the given number
+  of bytes. Returns true if the end of the list was reached.
+*/
+
+static
+bool advance(const buffers &bufs, unsigned int &idx, size_t &offset,
+             size_t howmuch)
+{
+  offset += howmuch;
+
+  for (unsigned int end = bufs.buf_count(); idx != end; ++idx)
+  {
+    size_t size = bufs.get_buffer(idx).size();
+    if (offset < size)
+      return false;
+    offset -= size;
+  }
+
+  return true;
+}
+
+
+/*
+  Note: All the remaining buffers are filled (sent) with a single system call
+  (see the vectored variants of detail::recv_some() and detail::send_some()).
+*/
+
 bool Socket_base::Read_op::do_cont()
 {
   if (is_completed())
@@ -245,24 +273,15 @@ bool Socket_base::Read_op::do_cont()
 
   Impl& impl = m_conn.get_base_impl();
 
-  const bytes& buffer = m_bufs.get_buffer(m_currentBufferIdx);
-  byte* data =buffer.begin() + m_currentBufferOffset;
-  size_t buffer_size = buffer.size() - m_currentBufferOffset;
-
-  m_currentBufferOffset += detail::recv_some(impl.m_sock, data, buffer_size, 0);
-
-  if (m_currentBufferOffset == buffer.size())
-  {
-    ++m_currentBufferIdx;
+  size_t howmuch = detail::recv_some(
+    impl.m_sock, m_bufs, m_currentBufferIdx, m_currentBufferOffset, false
+  );
 
-    if (m_currentBufferIdx == m_bufs.buf_count())
-    {
-      set_completed(m_bufs.length());
-      return true;
-    }
-  }
+  if (!advance(m_bufs, m_currentBufferIdx, m_currentBufferOffset, howmuch))
+    return false;
 
-  return false;
+  set_completed(m_bufs.length());
+  return true;
 }
 
 
@@ -273,16 +292,12 @@ void Socket_base::Read_op::do_wait()
 
   Impl& impl = m_conn.get_base_impl();
 
-  for (unsigned int end = m_bufs.buf_count(); m_currentBufferIdx != end; ++m_currentBufferIdx)
-  {
-    const bytes& buffer = m_bufs.get_buffer(m_currentBufferIdx);
-    byte* data = buffer.begin() + m_currentBufferOffset;
-    size_t buffer_size = buffer.size() - m_currentBufferOffset;
+  // TODO: Implement operation deadline.
 
-    detail::recv(impl.m_sock, data, buffer_size); // TODO: Implement operation deadline.
-
-    m_currentBufferOffset = 0;
-  }
+  while (!advance(m_bufs, m_currentBufferIdx, m_currentBufferOffset,
+                  detail::recv_some(impl.m_sock, m_bufs, m_currentBufferIdx,
+                                    m_currentBufferOffset, true)))
+  {}
 
   set_completed(m_bufs.length());
 }
@@ -345,24 +360,15 @@ bool Socket_base::Write_op::do_cont()
 
   Impl& impl = m_conn.get_base_impl();
 
-  const bytes& buffer = m_bufs.get_buffer(m_currentBufferIdx);
-  byte* data = buffer.begin() + m_currentBufferOffset;
-  size_t buffer_size = buffer.size() - m_currentBufferOffset;
+  size_t howmuch = detail::send_some(
+    impl.m_sock, m_bufs, m_currentBufferIdx, m_currentBufferOffset, false
+  );
 
-  m_currentBufferOffset += detail::send_some(impl.m_sock, data, buffer_size, 0);
-
-  if (m_currentBufferOffset == buffer.size())
-  {
-    ++m_currentBufferIdx;
-
-    if (m_currentBufferIdx == m_bufs.buf_count())
-    {
-      set_completed(m_bufs.length());
-      return true;
-    }
-  }
+  if (!advance(m_bufs, m_currentBufferIdx, m_currentBufferOffset, howmuch))
+    return false;
 
-  return false;
+  set_completed(m_bufs.length());
+  return true;
 }
 
 
@@ -373,16 +379,12 @@ void Socket_base::Write_op::do_wait()
 
   Impl& impl = m_conn.get_base_impl();
 
-  for (unsigned int end = m_bufs.buf_count(); m_currentBufferIdx != end; ++m_currentBufferIdx)
-  {
-    const bytes& buffer = m_bufs.get_buffer(m_currentBufferIdx);
-    byte* data = buffer.begin() + m_currentBufferOffset;
-    size_t buffer_size = buffer.size() - m_currentBufferOffset;
-
-    detail::send(impl.m_sock, data, buffer_size); // TODO: Implement operation deadline.
+  // TODO: Implement operation deadline.
 
-    m_currentBufferOffset = 0;
-  }
+  while (!advance(m_bufs, m_currentBufferIdx, m_currentBufferOffset,
+                  detail::send_some(impl.m_sock, m_bufs, m_currentBufferIdx,
+                                    m_currentBufferOffset, true)))
+  {}
 
   set_completed(m_bufs.length());
 }
@@ -446,6 +448,25 @@ bool Socket_base::is_closed() const
   return !(get_base_impl().is_open());
 }
 
+bool Socket_base::is_peer_closed() const
+{
+  const Impl &impl = get_base_impl();
+
+  if (!impl.is_open())
+    return true;
+
+  try
+  {
+    return 0 < detail::poll_one(impl.m_sock, detail::POLL_MODE_READ, false)
+           && 0 == detail::bytes_available(impl.m_sock);
+  }
+  catch (...)
+  {
+    // Socket is in an erroneous state.
+    return true;
+  }
+}
+
 unsigned int Socket_base::get_fd() const
 {
   return static_cast<unsigned int>(get_base_impl().m_sock);
@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2.0, as
+ * published by the Free Software Foundation.
+ *
+ * This program is also distributed with certain software (including
+ * but not limited to OpenSSL) that is licensed under separate terms,
+ * as designated in a particular file or component or in included license
+ * documentation.  The authors of MySQL hereby grant you an
+ * additional permission to link the program and your derivative works
+ * with the separately licensed software that they have included with
+ * MySQL.
+ *
+ * Without limiting anything contained in the foregoing, this file,
+ * which is part of MySQL Connector/C++, is also subject to the
+ * Universal FOSS Exception, version 1.0, a copy of which can be found at
+ * http://oss.oracle.com/licenses/universal-foss-exception.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License, version 2.0, for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin St, Fifth Floor, Boston, MA 02110-1301  USA
+ */
+
+#include <mysql/cdk/foundation/endpoint_health.h>
+
+
+namespace cdk {
+namespace foundation {
+
+
+const std::chrono::milliseconds Endpoint_health::min_backoff(1000);
+const std::chrono::milliseconds Endpoint_health::max_backoff(60000);
+
+
+Endpoint_health& Endpoint_health::instance()
+{
+  static Endpoint_health health;
+  return health;
+}
+
+
+bool Endpoint_health::available(const std::string &endpoint)
+{
+  std::lock_guard<std::mutex> guard(m_lock);
+  auto it = m_state.find(endpoint);
+
+  if (it == m_state.end())
+    return true;
+
+  State &state = it->second;
+
+  if (state.probing || now() < state.retry_at)
+    return false;
+
+  state.probing = true;
+  return true;
+}
+
+
+void Endpoint_health::report(const std::string &endpoint, bool success)
+{
+  std::lock_guard<std::mutex> guard(m_lock);
+
+  if (success)
+  {
+    m_state.erase(endpoint);
+    return;
+  }
+
+  State &state = m_state[endpoint];
+  auto backoff = min_backoff;
+
+  for (unsigned i = 0; i < state.failures && backoff < max_backoff; ++i)
+    backoff *= 2;
+
+  if (backoff > max_backoff)
+    backoff = max_backoff;
+
+  state.failures++;
+  state.probing = false;
+  state.retry_at = now() + backoff;
+}
+
+
+bool Endpoint_selector::skip(const std::string &endpoint)
+{
+  if (!m_first_pass)
+    return 0 == m_skipped.count(endpoint);
+
+  if (m_health.available(endpoint))
+    return false;
+
+  m_skipped.insert(endpoint);
+  return true;
+}
+
+
+bool Endpoint_selector::next_pass()
+{
+  if (!m_first_pass || m_skipped.empty())
+    return false;
+
+  m_first_pass = false;
+  return true;
+}
+
+
+}}  // cdk::foundation
@@ -43,6 +43,8 @@ PUSH_SYS_WARNINGS_CDK
 #include <forward_list>
 #include <map>
 #include <functional>
+#include <vector>
+#include <exception>
 #include <iostream>
 
 #ifndef _WIN32
@@ -565,7 +567,7 @@ addrinfo* addrinfo_from_string(const char* host_name, unsigned short port)
     throw_error("Invalid port.");
 
   hints.ai_flags = AI_NUMERICSERV;
-  hints.ai_family = AF_INET;
+  hints.ai_family = AF_UNSPEC;
   hints.ai_socktype = SOCK_STREAM;
 
   if (inet_pton(AF_INET, host_name, &addr) == 1)
@@ -599,21 +601,35 @@ addrinfo* addrinfo_from_string(const char* host_name, unsigned short port)
 }
 
 
-DIAGNOSTIC_PUSH_CDK
+/*
+  Resolver cache
+  ==============
+
+  Results of host name resolution are kept in a process-wide cache so that
+  opening many connections to the same host (for example when filling
+  a connection pool) does not make a blocking `getaddrinfo()` call for each
+  of them. Successful results are kept for `ttl`. Failures are cached
+  for the shorter `negative_ttl`, unless an expired successful result
+  for the same host is available. In that case the stale addresses are used,
+  so that a temporary resolver outage does not prevent connecting to a host
+  which was resolved before.
+*/
 
-#ifdef _MSC_VER
-  // 4189 = local variable is initialized but not referenced
-  DISABLE_WARNING_CDK(4189)
-#endif
+const seconds Resolver_cache::ttl(30);
+const seconds Resolver_cache::negative_ttl(2);
+const size_t  Resolver_cache::max_size = 256;
 
-Socket connect(const char *host_name, unsigned short port,
-               uint64_t timeout_usec)
+
+/*
+  Resolve host name and return the addresses ordered so that address
+  families alternate, starting with the family of the first address
+  returned by the resolver (RFC 8305, section 4).
+*/
+
+Addr_list Resolver_cache::lookup(const char *host_name, unsigned short port)
 {
-  Socket socket = NULL_SOCKET;
   addrinfo* host_list = NULL;
-  auto deadline = system_clock::now() + microseconds(timeout_usec);
 
-  // Resolve host name.
   // TODO: Configurable number of attempts
   int attempts = 2;
   while (!host_list)
@@ -621,15 +637,7 @@ Socket connect(const char *host_name, unsigned short port,
     attempts--;
     try
     {
-      /*
-        The DNS async resolution is not supported on all platforms.
-        Therefore, we will do the blocking call and measure the time
-      */
       host_list = detail::addrinfo_from_string(host_name, port);
-      if (timeout_usec > 0 && system_clock::now() >= deadline)
-      {
-        throw Connect_timeout_error(timeout_usec / 1000);
-      }
     }
     catch (Error& e)
     {
@@ -645,88 +653,317 @@ Socket connect(const char *host_name, unsigned short port,
   }
   guard = { host_list };
 
-  // Connect to host.
-  int connect_result = SOCKET_ERROR;
-  addrinfo* host = host_list;
+  Addr_list preferred;
+  Addr_list other;
 
-  while (connect_result != 0 && host)
+  for (addrinfo *host = host_list; host; host = host->ai_next)
   {
-    try
+    if (host->ai_addrlen > sizeof(sockaddr_storage))
+      continue;
+
+    Resolved_addr addr = {};
+    addr.family = host->ai_family;
+    addr.socktype = host->ai_socktype;
+    addr.protocol = host->ai_protocol;
+    addr.addrlen = static_cast<socklen_t>(host->ai_addrlen);
+    memcpy(&addr.addr, host->ai_addr, host->ai_addrlen);
+
+    if (addr.family == host_list->ai_family)
+      preferred.push_back(addr);
+    else
+      other.push_back(addr);
+  }
+
+  if (preferred.empty())
+    throw_error(std::string("Invalid host name: ") + host_name);
+
+  Addr_list result;
+  auto pref_it = preferred.begin();
+  auto other_it = other.begin();
+
+  while (pref_it != preferred.end() || other_it != other.end())
+  {
+    if (pref_it != preferred.end())
+      result.push_back(*pref_it++);
+    if (other_it != other.end())
+      result.push_back(*other_it++);
+  }
+
+  return result;
+}
+
+
+Addr_list Resolver_cache::get(const Entry &entry)
+{
+  // Note: a new exception is thrown in each thread that finds a cached
+  // error, to not share exception object between threads.
+
+  if (entry.failed)
+    throw Error(entry.code, entry.description);
+  return entry.addrs;
+}
+
+
+Addr_list Resolver_cache::resolve(const char *host_name, unsigned short port)
+{
+  Key key(host_name, port);
+  Addr_list stale;
+
+  {
+    std::lock_guard<std::mutex> guard(m_lock);
+    auto it = m_entries.find(key);
+
+    if (it != m_entries.end())
+    {
+      if (now() < it->second.expires)
+        return get(it->second);
+      stale = it->second.addrs;
+    }
+  }
+
+  // Note: lookup is done without holding the lock.
+
+  Entry entry;
+
+  try
+  {
+    entry.addrs = lookup(host_name, port);
+    entry.expires = now() + ttl;
+  }
+  catch (Error &e)
+  {
+    if (stale.empty())
+    {
+      entry.failed = true;
+      entry.code = e.code();
+      entry.description = e.description();
+    }
+    else
+      entry.addrs = std::move(stale);
+    entry.expires = now() + negative_ttl;
+  }
+
+  std::lock_guard<std::mutex> guard(m_lock);
+
+  if (m_entries.size() >= max_size)
+  {
+    auto time = now();
+    for (auto it = m_entries.begin(); it != m_entries.end();)
+    {
+      if (it->second.expires <= time)
+        it = m_entries.erase(it);
+      else
+        ++it;
+    }
+    if (m_entries.size() >= max_size)
+      m_entries.clear();
+  }
+
+  return get(m_entries[key] = std::move(entry));
+}
+
+
+static Resolver_cache& resolver_cache()
+{
+  static Resolver_cache instance;
+  return instance;
+}
+
+
+/*
+  If host name resolves to several addresses, connection attempts are
+  staggered as described in RFC 8305 ("happy eyeballs"): a new attempt
+  is started if the previous one did not complete within
+  `connect_attempt_delay` or as soon as it fails, without abandoning
+  attempts that are still in progress. The first attempt that succeeds
+  wins. This way an unreachable address (such as a dead IPv6 path) delays
+  connection by at most `connect_attempt_delay` instead of the whole
+  connect timeout.
+*/
+
+static const milliseconds connect_attempt_delay(250);
+
+
+// Convert remaining time to poll() timeout, rounding up.
+
+static int poll_timeout(system_clock::duration left)
+{
+  auto msec = duration_cast<milliseconds>(left).count() + 1;
+  if (msec < 0)
+    return 0;
+  if (msec > std::numeric_limits<int>::max())
+    return std::numeric_limits<int>::max();
+  return static_cast<int>(msec);
+}
+
+
+DIAGNOSTIC_PUSH_CDK
+
+#ifdef _MSC_VER
+  // 4189 = local variable is initialized but not referenced
+  DISABLE_WARNING_CDK(4189)
+#endif
+
+Socket connect(const char *host_name, unsigned short port,
+               uint64_t timeout_usec)
+{
+  auto deadline = system_clock::now() + microseconds(timeout_usec);
+
+  /*
+    The DNS async resolution is not supported on all platforms.
+    Therefore, we will do the blocking call and measure the time
+  */
+
+  Addr_list addrs = resolver_cache().resolve(host_name, port);
+
+  if (timeout_usec > 0 && system_clock::now() >= deadline)
+  {
+    throw Connect_timeout_error(timeout_usec / 1000);
+  }
+
+  // Sockets with connection attempts in progress, closed when abandoned.
+
+  struct Attempts : std::vector<pollfd>
+  {
+    ~Attempts()
+    {
+      for (auto &fd : *this)
+        close(fd.fd);
+    }
+  }
+  pending;
+
+  std::exception_ptr last_error;
+  size_t next = 0;
+  auto next_attempt = system_clock::now();
+
+  while (true)
+  {
+    auto now = system_clock::now();
+
+    if (timeout_usec > 0 && now >= deadline)
+    {
+      // Throw the error in milliseconds, which we did not adjust.
+      // Otherwise the user will be confused why the timeout
+      // in the error message is smaller than defined
+      // (original timeout minus DNS resolution time)
+      throw Connect_timeout_error(timeout_usec / 1000);
+    }
+
+    // Start next attempt if it is due or if there are no pending ones.
+
+    if (next < addrs.size() && (pending.empty() || now >= next_attempt))
     {
-      socket = detail::socket(true, host);
-      connect_result = ::connect(socket, host->ai_addr, static_cast<int>(host->ai_addrlen));
+      const Resolved_addr &addr = addrs[next++];
+      Socket socket = NULL_SOCKET;
+      next_attempt = now + connect_attempt_delay;
 
-      if (connect_result != 0)
+      try
       {
+        addrinfo hints = {};
+        hints.ai_family = addr.family;
+        hints.ai_socktype = addr.socktype;
+        hints.ai_protocol = addr.protocol;
+
+        socket = detail::socket(true, &hints);
+
+        int connect_result = ::connect(
+          socket, reinterpret_cast<const sockaddr*>(&addr.addr),
+          static_cast<int>(addr.addrlen)
+        );
+
+        if (0 == connect_result)
+          return socket;
+
       #ifdef _WIN32
-        if (connect_result == SOCKET_ERROR && WSAGetLastError() == WSAEWOULDBLOCK)
+        if (WSAGetLastError() != WSAEWOULDBLOCK)
       #else
-        if (connect_result == SOCKET_ERROR && errno == EINPROGRESS)
+        if (errno != EINPROGRESS)
       #endif
-        {
-
-          int select_result = 0;
-
-          do{
-
-            auto timeout = duration_cast<microseconds>(
-              deadline - system_clock::now()
-            ).count();
-
-            select_result = poll_one(
-                              socket, POLL_MODE_CONNECT, true,
-                              0 == timeout_usec ? 0 : timeout > 0 ? timeout : 1
-                                                                    );
-          // Note: if poll_one() returns 0 then, according to POSIX specs:
-          // A value of 0 indicates that the call timed out and no file descriptors have been selected
-          // Due to a bug on WSApool, it may return 0 even if no timeout occur..
-          // So we will check if timeout occurs and try again if not
-
-          } while ((select_result == 0) &&
-                   ((timeout_usec == 0) ||
-                    (std::chrono::system_clock::now() < deadline)
-                    )
-                   );
-
-          if ((timeout_usec > 0) &&
-              (std::chrono::system_clock::now() >= deadline))
-          {
-            // Throw the error in milliseconds, which we did not adjust.
-            // Otherwise the user will be confused why the timeout
-            // in the error message is smaller than defined
-            // (original timeout minus DNS resolution time)
-            throw Connect_timeout_error(timeout_usec / 1000);
-          }
-
-          if (select_result < 0)
-            throw_socket_error();
-          else
-            check_socket_error(socket);
-
-          connect_result = 0;
-        }
-        else
         {
           throw_socket_error();
+          throw_error("Failed to connect socket.");
         }
+
+        pollfd fd = {};
+        fd.fd = socket;
+        fd.events = POLLOUT;
+        pending.push_back(fd);
+      }
+      catch (...)
+      {
+        if (NULL_SOCKET != socket)
+          close(socket);
+        last_error = std::current_exception();
+        next_attempt = now;
       }
+
+      continue;
     }
-    catch (Connect_timeout_error&)
+
+    if (pending.empty())
     {
-      close(socket);
-      throw;
+      // All attempts have failed.
+      assert(last_error);
+      std::rethrow_exception(last_error);
     }
-    catch (...)
+
+    // Wait until the deadline or until the next attempt is due.
+
+    int timeout = -1;
+
+    if (next < addrs.size())
+      timeout = poll_timeout(next_attempt - now);
+
+    if (timeout_usec > 0)
     {
-      close(socket);
+      int left = poll_timeout(deadline - now);
+      if (timeout < 0 || left < timeout)
+        timeout = left;
+    }
 
-      host = host->ai_next;
-      if (!host)
-        throw;
+    // Note: Due to a bug on WSAPoll, it may return 0 even if no timeout
+    // occurred. This is handled by the loop.
+
+  #ifdef _WIN32
+    int poll_result = ::WSAPoll(pending.data(),
+                                static_cast<ULONG>(pending.size()), timeout);
+  #else
+    int poll_result = ::poll(pending.data(),
+                             static_cast<nfds_t>(pending.size()), timeout);
+  #endif
+
+    if (poll_result < 0)
+      throw_socket_error();
+
+    for (auto it = pending.begin(); it != pending.end();)
+    {
+      if (!it->revents)
+      {
+        ++it;
+        continue;
+      }
+
+      Socket socket = it->fd;
+      it = pending.erase(it);
+
+      try
+      {
+        check_socket_error(socket);
+      }
+      catch (...)
+      {
+        close(socket);
+        last_error = std::current_exception();
+        next_attempt = system_clock::now();
+        continue;
+      }
+
+      // Connected - remaining attempts are closed by `pending` destructor.
+
+      return socket;
     }
   }
-
-  return socket;
 }
 
 DIAGNOSTIC_POP_CDK
@@ -905,10 +1142,13 @@ size_t bytes_available(Socket socket)
 }
 
 
+/*
+  Note: MSG_WAITALL is not used by recv() because CDK sockets are
+  non-blocking, in which case the flag has no effect.
+*/
+
 void recv(Socket socket, byte *buffer, size_t buffer_size)
 {
-  // TODO: Investigate if more efficient implementation is possible with ::recv() and MSG_WAITALL flag.
-
   if (buffer_size == 0)
     return;
 
@@ -931,6 +1171,60 @@ void send(Socket socket, const byte *buffer, size_t buffer_size)
 }
 
 
+/*
+  Optimistic I/O
+  --------------
+
+  Functions recv_some() and send_some() first try to read or write data
+  without polling the socket. Only if the operation would block and the
+  caller wants to wait, poll_one() is used to wait until the socket becomes
+  ready and then the operation is tried again. When data (or buffer space)
+  is available, which is the common case, this saves one system call per
+  I/O operation. A deadline, if one is ever implemented, should be applied
+  to the poll_one() call, as this is the only place where we wait.
+
+  Flag MSG_DONTWAIT makes sure that the first attempt does not block even
+  if the socket is in blocking mode (sockets created by CDK are
+  non-blocking, which is the only option on Windows).
+*/
+
+#ifdef MSG_DONTWAIT
+static const int dontwait_flag = MSG_DONTWAIT;
+#else
+static const int dontwait_flag = 0;
+#endif
+
+
+static
+bool would_block()
+{
+#ifdef _WIN32
+  return WSAGetLastError() == WSAEWOULDBLOCK;
+#else
+  return errno == EAGAIN || errno == EWOULDBLOCK;
+#endif
+}
+
+
+/*
+  Called after an I/O attempt which would block. Returns false if caller
+  does not want to wait, otherwise waits until the socket is ready for
+  the I/O and returns true.
+*/
+
+static
+bool wait_for(Socket socket, Poll_mode mode, bool wait)
+{
+  if (!wait)
+    return false;
+
+  if (poll_one(socket, mode, true) < 0)
+    throw_socket_error();
+
+  return true;
+}
+
+
 size_t recv_some(Socket socket, byte *buffer, size_t buffer_size, bool wait)
 {
   if (buffer_size == 0)
@@ -943,50 +1237,26 @@ size_t recv_some(Socket socket, byte *buffer, size_t buffer_size, bool wait)
   assert(buffer_size > 0);
   assert(buffer_size < (size_t)std::numeric_limits<int>::max());
 
-  size_t bytes_received = 0;
-
-  int select_result = poll_one(socket, POLL_MODE_READ, wait);
+  do {
 
-  if (select_result > 0)
-  {
     int recv_result = ::recv(socket, reinterpret_cast<char *>(buffer),
-                             static_cast<int>(buffer_size), 0);
+                             static_cast<int>(buffer_size), dontwait_flag);
 
     if (recv_result == 0)
-    {
       throw connection::Error_eos();
-    }
-    else if (recv_result == SOCKET_ERROR)
-    {
-#ifdef _WIN32
-      if (WSAGetLastError() == WSAEWOULDBLOCK)
-#else
-      if (errno == EAGAIN || errno == EWOULDBLOCK)
-#endif
-      {
-        bytes_received = 0;
-      }
-      else
-      {
-        throw_socket_error();
-      }
-    }
-    else
+
+    if (recv_result != SOCKET_ERROR)
     {
       assert(recv_result > 0);
-      bytes_received = static_cast<size_t>(recv_result);
+      return static_cast<size_t>(recv_result);
     }
-  }
-  else if (select_result == 0)
-  {
-    return 0;
-  }
-  else
-  {
-    throw_socket_error();
-  }
 
-  return bytes_received;
+    if (!would_block())
+      throw_socket_error();
+
+  } while (wait_for(socket, POLL_MODE_READ, wait));
+
+  return 0;
 }
 
 
@@ -1002,48 +1272,156 @@ size_t send_some(Socket socket, const byte *buffer, size_t buffer_size, bool wai
   assert(buffer_size > 0);
   assert(buffer_size < (size_t)std::numeric_limits<int>::max());
 
-  size_t bytes_sent = 0;
-
-  int select_result = poll_one(socket, POLL_MODE_WRITE, wait);
+  do {
 
-  if (select_result > 0)
-  {
     int send_result = ::send(socket, reinterpret_cast<const char *>(buffer),
-                             static_cast<int>(buffer_size), 0);
+                             static_cast<int>(buffer_size), dontwait_flag);
 
-    if (send_result == SOCKET_ERROR)
+    if (send_result != SOCKET_ERROR)
     {
+      assert(send_result >= 0);
+      return static_cast<size_t>(send_result);
+    }
+
+    if (!would_block())
+      throw_socket_error();
+
+  } while (wait_for(socket, POLL_MODE_WRITE, wait));
+
+  return 0;
+}
+
+
+/*
+  Vectored I/O
+  ------------
+
+  A list of buffers is described to the system as an array of I/O vectors
+  (struct iovec or WSABUF on Windows). At most max_io_vecs buffers are
+  transferred in a single call -- the rest is handled by the next one.
+*/
+
 #ifdef _WIN32
-      if (WSAGetLastError() == WSAEWOULDBLOCK)
+typedef WSABUF Io_vec;
 #else
-      if (errno == EAGAIN || errno == EWOULDBLOCK)
+typedef struct iovec Io_vec;
+#endif
+
+static const unsigned max_io_vecs = 16;
+
+
+static
+unsigned fill_io_vecs(Io_vec *vecs, const buffers &bufs, unsigned idx,
+                      size_t offset)
+{
+  unsigned count = 0;
+
+  for (unsigned end = bufs.buf_count(); idx < end && count < max_io_vecs;
+       ++idx, offset = 0)
+  {
+    bytes buf = bufs.get_buffer(idx);
+
+    if (buf.size() <= offset)
+      continue;
+
+    byte  *data = buf.begin() + offset;
+    size_t size = buf.size() - offset;
+
+#ifdef _WIN32
+    vecs[count].buf = reinterpret_cast<char*>(data);
+    vecs[count].len = static_cast<ULONG>(size);
+#else
+    vecs[count].iov_base = data;
+    vecs[count].iov_len = size;
+#endif
+    ++count;
+  }
+
+  return count;
+}
+
+
+size_t recv_some(Socket socket, const buffers &bufs, unsigned idx,
+                 size_t offset, bool wait)
+{
+  Io_vec vecs[max_io_vecs];
+  unsigned count = fill_io_vecs(vecs, bufs, idx, offset);
+
+  if (0 == count)
+    return 0;
+
+  do {
+
+#ifdef _WIN32
+
+    DWORD received = 0;
+    DWORD flags = 0;
+
+    if (SOCKET_ERROR
+        != ::WSARecv(socket, vecs, count, &received, &flags, NULL, NULL))
+#else
+
+    struct msghdr msg = {};
+    msg.msg_iov = vecs;
+    msg.msg_iovlen = count;
+
+    ssize_t received = ::recvmsg(socket, &msg, dontwait_flag);
+
+    if (received >= 0)
 #endif
-      {
-        bytes_sent = 0;
-      }
-      else
-      {
-        throw_socket_error();
-      }
-    }
-    else
     {
-      assert(send_result >= 0);
-      bytes_sent = static_cast<size_t>(send_result);
+      if (0 == received)
+        throw connection::Error_eos();
+      return static_cast<size_t>(received);
     }
-  }
-  else if (select_result == 0)
-  {
+
+    if (!would_block())
+      throw_socket_error();
+
+  } while (wait_for(socket, POLL_MODE_READ, wait));
+
+  return 0;
+}
+
+
+size_t send_some(Socket socket, const buffers &bufs, unsigned idx,
+                 size_t offset, bool wait)
+{
+  Io_vec vecs[max_io_vecs];
+  unsigned count = fill_io_vecs(vecs, bufs, idx, offset);
+
+  if (0 == count)
     return 0;
-  }
-  else
-  {
-    throw_socket_error();
-  }
 
-  return bytes_sent;
+  do {
+
+#ifdef _WIN32
+
+    DWORD sent = 0;
+
+    if (SOCKET_ERROR
+        != ::WSASend(socket, vecs, count, &sent, 0, NULL, NULL))
+#else
+
+    struct msghdr msg = {};
+    msg.msg_iov = vecs;
+    msg.msg_iovlen = count;
+
+    ssize_t sent = ::sendmsg(socket, &msg, dontwait_flag);
+
+    if (sent >= 0)
+#endif
+      return static_cast<size_t>(sent);
+
+    if (!would_block())
+      throw_socket_error();
+
+  } while (wait_for(socket, POLL_MODE_WRITE, wait));
+
+  return 0;
 }
 
+
 std::string get_local_hostname()
 {
   char buf[1024] = {0};
@@ -1053,8 +1431,36 @@ std::string get_local_hostname()
   return buf;
 }
 
+
+std::string get_peer_address(Socket socket)
+{
+  sockaddr_storage addr;
+  socklen_t addr_len = sizeof(addr);
+
+  if (0 != ::getpeername(socket, (sockaddr*)&addr, &addr_len))
+    return std::string();
+
+  char host[NI_MAXHOST];
+  char port[NI_MAXSERV];
+
+  if (0 != ::getnameinfo(
+    (sockaddr*)&addr, addr_len, host, sizeof(host), port, sizeof(port),
+    NI_NUMERICHOST | NI_NUMERICSERV
+  ))
+    return std::string();
+
+  return std::string(host) + ":" + port;
+}
+
+/*
+  Query DNS for SRV records of the given name. Minimal TTL of the returned
+  records is stored in `ttl`.
+*/
+
 #ifdef _WIN32
-std::forward_list<Srv_host_detail> srv_list(const std::string &hostname)
+static
+std::forward_list<Srv_host_detail> srv_query(const std::string &hostname,
+                                             uint32_t &ttl)
 {
   DNS_STATUS status;               //Return value of  DnsQuery_A() function.
   PDNS_RECORD pDnsRecord =nullptr;          //Pointer to DNS_RECORD structure.
@@ -1071,6 +1477,9 @@ std::forward_list<Srv_host_detail> srv_list(const std::string &hostname)
     {
       if (pRecord->wType == DNS_TYPE_SRV)
       {
+        if (srv.empty() || pRecord->dwTtl < ttl)
+          ttl = pRecord->dwTtl;
+
         srv_it = srv.emplace_after(srv_it,
           Srv_host_detail
         {
@@ -1090,7 +1499,9 @@ std::forward_list<Srv_host_detail> srv_list(const std::string &hostname)
 }
 #else
 
-std::forward_list<Srv_host_detail> srv_list(const std::string &hostname)
+static
+std::forward_list<Srv_host_detail> srv_query(const std::string &hostname,
+                                             uint32_t &ttl)
 {
   struct __res_state state {};
   res_ninit(&state);
@@ -1136,6 +1547,8 @@ std::forward_list<Srv_host_detail> srv_list(const std::string &hostname)
     {
           ns_rr rr;
           ns_parserr(&msg, ns_s_an, x, &rr);
+          if (0 == x || ns_rr_ttl(rr) < ttl)
+            ttl = ns_rr_ttl(rr);
           process(rr);
     }
   }
@@ -1145,4 +1558,124 @@ std::forward_list<Srv_host_detail> srv_list(const std::string &hostname)
 }
 #endif
 
+
+/*
+  SRV cache
+  =========
+
+  Results of SRV queries are cached per host name for the TTL of the
+  returned records and shared by all connections created in the process.
+
+  An entry is refreshed ahead of its expiry: the first thread that uses it
+  during the last quarter of its lifetime queries DNS again, without holding
+  the cache lock. Other threads keep using the cached list in the meantime,
+  also if it has already expired. Only if there is no list for the host yet,
+  they wait for the query to complete instead of issuing their own queries.
+  This way a single query is made for a host at any time. If a query fails
+  or returns no records, the current list is used for another `retry_ttl`.
+
+  Note: Refresh is done by the thread that uses the cache, not in a separate
+  one, so that no thread outlives the cache.
+*/
+
+const seconds Srv_cache::retry_ttl(5);
+
+
+auto Srv_cache::query(const std::string &hostname, uint32_t &ttl) -> Srv_list
+{
+  return srv_query(hostname, ttl);
+}
+
+
+// Note: must be called with m_lock held.
+
+void Srv_cache::store(const std::string &hostname, const Srv_list &list,
+                      clock::duration ttl)
+{
+  if (list.empty() || ttl <= clock::duration::zero())
+  {
+    m_entries.erase(hostname);
+    return;
+  }
+
+  Entry &entry = m_entries[hostname];
+  entry.list = list;
+  entry.ttl = ttl;
+  entry.expires = now() + ttl;
+}
+
+
+auto Srv_cache::get(const std::string &hostname) -> Srv_list
+{
+  std::unique_lock<std::mutex> lock(m_lock);
+  Srv_list current;
+
+  for (;;)
+  {
+    auto it = m_entries.find(hostname);
+
+    if (it == m_entries.end())
+      break;
+
+    Entry &entry = it->second;
+    auto time = now();
+
+    if (entry.refreshing)
+    {
+      if (!entry.list.empty())
+        return entry.list;
+      m_refreshed.wait(lock);
+      continue;
+    }
+
+    if (time < entry.expires && entry.expires - time > entry.ttl / 4)
+      return entry.list;
+
+    current = entry.list;
+    break;
+  }
+
+  // Note: an entry with empty list is created if there was none.
+
+  m_entries[hostname].refreshing = true;
+  lock.unlock();
+
+  // Note: query is done without holding the lock.
+
+  uint32_t ttl = 0;
+  Srv_list list;
+  std::exception_ptr error;
+
+  try
+  {
+    list = query(hostname, ttl);
+  }
+  catch (...)
+  {
+    error = std::current_exception();
+  }
+
+  lock.lock();
+  m_entries[hostname].refreshing = false;
+  m_refreshed.notify_all();
+
+  if (list.empty())
+  {
+    store(hostname, current, retry_ttl);
+    if (error && current.empty())
+      std::rethrow_exception(error);
+    return current;
+  }
+
+  store(hostname, list, seconds(ttl));
+  return list;
+}
+
+
+std::forward_list<Srv_host_detail> srv_list(const std::string &hostname)
+{
+  static Srv_cache cache;
+  return cache.get(hostname);
+}
+
 }}}} // cdk::foundation::connection::detail
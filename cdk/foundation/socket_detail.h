@@ -31,8 +31,14 @@
 #ifndef CDK_FOUNDATION_SOCKET_DETAIL_H
 #define CDK_FOUNDATION_SOCKET_DETAIL_H
 #include <mysql/cdk/foundation/types.h>
+#include <chrono>
+#include <condition_variable>
 #include <forward_list>
+#include <map>
+#include <mutex>
 #include <string>
+#include <system_error>
+#include <vector>
 
 PUSH_SYS_WARNINGS_CDK
 
@@ -49,6 +55,7 @@ PUSH_SYS_WARNINGS_CDK
 #include <sys/select.h>
 #include <sys/time.h>
 #include <sys/types.h>
+#include <sys/uio.h>
 #include <netinet/in.h>
 #include <fcntl.h>
 #include <netdb.h>
@@ -247,7 +254,11 @@ addrinfo* addrinfo_from_string(const char* host_name, unsigned short port);
     Connection failed.
 
   @note
-    This function always blocks.
+    This function always blocks. Host name resolution results are cached
+    process-wide for a short time. If the host resolves to several addresses,
+    connection attempts are started one after another with a short delay,
+    alternating between address families, and the first attempt to succeed
+    is used while others are abandoned.
 */
 
 Socket connect(const char *host, unsigned short port,
@@ -444,13 +455,82 @@ size_t recv_some(Socket socket, byte *buffer, size_t buffer_size, bool wait);
 size_t send_some(Socket socket, const byte *buffer, size_t buffer_size, bool wait);
 
 
+/**
+  Receives some data from a socket into a list of buffers.
+
+  Scatter version of `recv_some()`: data is received with a single system
+  call into buffers of the list, starting at position `offset` within buffer
+  number `idx`.
+
+  @param[in] socket
+    Socket used for reading.
+  @param[in] bufs
+    List of buffers.
+  @param[in] idx
+    Index of the first buffer to be filled.
+  @param[in] offset
+    Position within the first buffer at which data is stored.
+  @param[in] wait
+    If `true`, operation will block. Otherwise, it will return immediately.
+
+  @return
+    The number of bytes read from a socket.
+
+  @throw cdk::foundation::connection::Error_eos
+    End-of-stream encountered.
+  @throw cdk::foundation::Error
+    Socket read failed.
+*/
+
+size_t recv_some(Socket socket, const buffers &bufs, unsigned idx,
+                 size_t offset, bool wait);
+
+
+/**
+  Sends some data from a list of buffers to a socket.
+
+  Gather version of `send_some()`: data from buffers of the list, starting at
+  position `offset` within buffer number `idx`, is sent with a single system
+  call.
+
+  @param[in] socket
+    Socket used for sending.
+  @param[in] bufs
+    List of buffers.
+  @param[in] idx
+    Index of the first buffer to be sent.
+  @param[in] offset
+    Position within the first buffer from which data is sent.
+  @param[in] wait
+    If `true`, operation will block. Otherwise, it will return immediately.
+
+  @return
+    The number of bytes sent to a socket.
+
+  @throw cdk::foundation::Error
+    Socket write failed.
+*/
+
+size_t send_some(Socket socket, const buffers &bufs, unsigned idx,
+                 size_t offset, bool wait);
+
+
 /**
    @brief get_local_hostname returns hostname of the current machine
  */
 std::string get_local_hostname();
 
+/**
+   @brief get_peer_address returns numeric address and port of the peer
+   connected to the given socket, or empty string if it can not be
+   determined.
+ */
+std::string get_peer_address(Socket socket);
+
 /*
    Retrieve host SRV record (target:port) list for specified service and protocol
+
+   Results are cached process-wide for the TTL of the SRV records.
  */
 struct Srv_host_detail
 {
@@ -462,6 +542,126 @@ struct Srv_host_detail
 
 std::forward_list<Srv_host_detail> srv_list(const std::string &host_name);
 
+
+/*
+  Addresses to which a host name resolves.
+*/
+
+struct Resolved_addr
+{
+  int family;
+  int socktype;
+  int protocol;
+  sockaddr_storage addr;
+  socklen_t addrlen;
+};
+
+typedef std::vector<Resolved_addr> Addr_list;
+
+
+/*
+  Process-wide cache of host name resolution results used by connect()
+  (see socket_detail.cc). Methods lookup() and now() can be overridden
+  in tests.
+*/
+
+class Resolver_cache
+{
+public:
+
+  using clock = std::chrono::system_clock;
+
+  static const std::chrono::seconds ttl;
+  static const std::chrono::seconds negative_ttl;
+  static const size_t max_size;
+
+  virtual ~Resolver_cache() {}
+
+  Addr_list resolve(const char *host_name, unsigned short port);
+
+protected:
+
+  virtual Addr_list lookup(const char *host_name, unsigned short port);
+
+  virtual clock::time_point now() const
+  {
+    return clock::now();
+  }
+
+private:
+
+  struct Entry
+  {
+    Addr_list addrs;
+
+    // Cached resolution error, used if `failed` is true.
+
+    bool failed = false;
+    std::error_code code;
+    std::string description;
+
+    clock::time_point expires;
+  };
+
+  typedef std::pair<std::string, unsigned short> Key;
+
+  std::mutex m_lock;
+  std::map<Key, Entry> m_entries;
+
+  static Addr_list get(const Entry &entry);
+};
+
+
+/*
+  Process-wide cache of SRV query results used by srv_list() (see
+  socket_detail.cc). Methods query() and now() can be overridden in tests.
+*/
+
+class Srv_cache
+{
+public:
+
+  using clock = std::chrono::system_clock;
+  typedef std::forward_list<Srv_host_detail> Srv_list;
+
+  static const std::chrono::seconds retry_ttl;
+
+  virtual ~Srv_cache() {}
+
+  Srv_list get(const std::string &hostname);
+
+protected:
+
+  /*
+    Query DNS for SRV records of the given name. Minimal TTL of the returned
+    records is stored in `ttl`.
+  */
+
+  virtual Srv_list query(const std::string &hostname, uint32_t &ttl);
+
+  virtual clock::time_point now() const
+  {
+    return clock::now();
+  }
+
+private:
+
+  struct Entry
+  {
+    Srv_list list;
+    clock::time_point expires;
+    clock::duration ttl;
+    bool refreshing = false;  // a query for this entry is in progress
+  };
+
+  std::mutex m_lock;
+  std::condition_variable m_refreshed;
+  std::map<std::string, Entry> m_entries;
+
+  void store(const std::string &hostname, const Srv_list &list,
+             clock::duration ttl);
+};
+
 }}}} // cdk::foundation::connection::detail
 
 
@@ -0,0 +1,308 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2.0, as
+ * published by the Free Software Foundation.
+ *
+ * This program is also distributed with certain software (including
+ * but not limited to OpenSSL) that is licensed under separate terms,
+ * as designated in a particular file or component or in included license
+ * documentation.  The authors of MySQL hereby grant you an
+ * additional permission to link the program and your derivative works
+ * with the separately licensed software that they have included with
+ * MySQL.
+ *
+ * Without limiting anything contained in the foregoing, this file,
+ * which is part of MySQL Connector/C++, is also subject to the
+ * Universal FOSS Exception, version 1.0, a copy of which can be found at
+ * http://oss.oracle.com/licenses/universal-foss-exception.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License, version 2.0, for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin St, Fifth Floor, Boston, MA 02110-1301  USA
+ */
+
+/**
+  Unit tests for caches of DNS query results.
+
+  - Resolver_cache: caching of resolved addresses and of resolution errors,
+    using stale addresses when resolution fails
+
+  - Srv_cache: caching for the TTL of SRV records, refreshing records ahead
+    of expiry by a single query, using stale records when query returns none
+    or fails, not caching records with zero TTL
+*/
+
+#include "test.h"
+#include "../socket_detail.h"
+#include <mysql/cdk/foundation/error.h>
+#include <functional>
+
+using namespace cdk::foundation;
+using namespace cdk::foundation::connection::detail;
+using std::chrono::seconds;
+
+
+/*
+  Resolver_cache with a clock that is moved forward explicitly and a lookup
+  function that returns one address (with port set to the number of lookups
+  done so far) or throws error if m_fail is true.
+*/
+
+struct Test_resolver : public Resolver_cache
+{
+  clock::time_point m_now = clock::now();
+  unsigned m_lookups = 0;
+  bool m_fail = false;
+
+  clock::time_point now() const override
+  {
+    return m_now;
+  }
+
+  Addr_list lookup(const char*, unsigned short) override
+  {
+    ++m_lookups;
+
+    if (m_fail)
+      throw_error("Test resolution error");
+
+    Resolved_addr addr = {};
+    addr.family = AF_INET;
+    addr.protocol = static_cast<int>(m_lookups);
+    return Addr_list(1, addr);
+  }
+};
+
+
+TEST(Foundation, resolver_cache)
+{
+  Test_resolver cache;
+
+  // Results are cached per host and port for the TTL.
+
+  EXPECT_EQ(1, cache.resolve("host", 1).at(0).protocol);
+  EXPECT_EQ(1, cache.resolve("host", 1).at(0).protocol);
+  EXPECT_EQ(2, cache.resolve("host", 2).at(0).protocol);
+  EXPECT_EQ(3, cache.resolve("other", 1).at(0).protocol);
+  EXPECT_EQ(3U, cache.m_lookups);
+
+  cache.m_now += Resolver_cache::ttl;
+
+  EXPECT_EQ(4, cache.resolve("host", 1).at(0).protocol);
+  EXPECT_EQ(4, cache.resolve("host", 1).at(0).protocol);
+  EXPECT_EQ(4U, cache.m_lookups);
+
+  // If resolution fails, the stale addresses are used for negative TTL.
+
+  cache.m_fail = true;
+  cache.m_now += Resolver_cache::ttl;
+
+  EXPECT_EQ(4, cache.resolve("host", 1).at(0).protocol);
+  EXPECT_EQ(5U, cache.m_lookups);
+
+  cache.m_now += Resolver_cache::negative_ttl - seconds(1);
+  EXPECT_EQ(4, cache.resolve("host", 1).at(0).protocol);
+  EXPECT_EQ(5U, cache.m_lookups);
+
+  cache.m_now += seconds(1);
+  EXPECT_EQ(4, cache.resolve("host", 1).at(0).protocol);
+  EXPECT_EQ(6U, cache.m_lookups);
+
+  // Error is cached for negative TTL if there are no stale addresses.
+
+  EXPECT_THROW(cache.resolve("new", 1), Error);
+  EXPECT_THROW(cache.resolve("new", 1), Error);
+  EXPECT_EQ(7U, cache.m_lookups);
+
+  cache.m_fail = false;
+  EXPECT_THROW(cache.resolve("new", 1), Error);
+  EXPECT_EQ(7U, cache.m_lookups);
+
+  cache.m_now += Resolver_cache::negative_ttl;
+  EXPECT_EQ(8, cache.resolve("new", 1).at(0).protocol);
+}
+
+
+TEST(Foundation, resolver_cache_size)
+{
+  Test_resolver cache;
+
+  // Cache does not grow above its maximal size.
+
+  for (unsigned port = 1; port <= Resolver_cache::max_size; ++port)
+    cache.resolve("host", static_cast<unsigned short>(port));
+
+  EXPECT_EQ(Resolver_cache::max_size, cache.m_lookups);
+  cache.resolve("host", 1);
+  EXPECT_EQ(Resolver_cache::max_size, cache.m_lookups);
+
+  // When it is full and no entry has expired, all entries are dropped.
+
+  cache.resolve("host", 0);
+  EXPECT_EQ(Resolver_cache::max_size + 1, cache.m_lookups);
+  cache.resolve("host", 0);
+  cache.resolve("host", 1);
+  EXPECT_EQ(Resolver_cache::max_size + 2, cache.m_lookups);
+}
+
+
+/*
+  Srv_cache with a clock that is moved forward explicitly and a query
+  function that returns m_list with m_ttl or throws error if m_fail is true.
+  If set, m_in_query is called during the query, as if another thread used
+  the cache at that time.
+*/
+
+struct Test_srv_cache : public Srv_cache
+{
+  clock::time_point m_now = clock::now();
+  unsigned m_queries = 0;
+  Srv_list m_list;
+  uint32_t m_ttl = 60;
+  bool m_fail = false;
+  std::function<void()> m_in_query;
+
+  clock::time_point now() const override
+  {
+    return m_now;
+  }
+
+  Srv_list query(const std::string&, uint32_t &ttl) override
+  {
+    ++m_queries;
+
+    if (m_in_query)
+      m_in_query();
+
+    if (m_fail)
+      throw_error("Test query error");
+
+    ttl = m_ttl;
+    return m_list;
+  }
+
+  void set_port(uint16_t port)
+  {
+    Srv_host_detail host = {};
+    host.port = port;
+    host.name = "target";
+    m_list.clear();
+    m_list.push_front(host);
+  }
+};
+
+
+TEST(Foundation, srv_cache)
+{
+  Test_srv_cache cache;
+
+  // Records are cached until the last quarter of their TTL.
+
+  cache.set_port(1);
+  EXPECT_EQ(1, cache.get("host").front().port);
+
+  cache.set_port(2);
+  cache.m_now += seconds(44);
+  EXPECT_EQ(1, cache.get("host").front().port);
+  EXPECT_EQ(1U, cache.m_queries);
+
+  // Then they are refreshed before they expire.
+
+  cache.m_now += seconds(1);
+  EXPECT_EQ(2, cache.get("host").front().port);
+  EXPECT_EQ(2U, cache.m_queries);
+  EXPECT_EQ(2, cache.get("host").front().port);
+  EXPECT_EQ(2U, cache.m_queries);
+
+  // Expired entry is refreshed too.
+
+  cache.set_port(3);
+  cache.m_now += seconds(60);
+  EXPECT_EQ(3, cache.get("host").front().port);
+  EXPECT_EQ(3U, cache.m_queries);
+
+  // If query returns no records, stale ones are used for retry TTL.
+
+  cache.m_list.clear();
+  cache.m_now += seconds(60);
+  EXPECT_EQ(3, cache.get("host").front().port);
+  EXPECT_EQ(4U, cache.m_queries);
+
+  cache.m_now += Srv_cache::retry_ttl - seconds(2);
+  EXPECT_EQ(3, cache.get("host").front().port);
+  EXPECT_EQ(4U, cache.m_queries);
+
+  cache.m_now += seconds(2);
+  EXPECT_EQ(3, cache.get("host").front().port);
+  EXPECT_EQ(5U, cache.m_queries);
+
+  // The same if query fails.
+
+  cache.m_fail = true;
+  cache.m_now += Srv_cache::retry_ttl;
+  EXPECT_EQ(3, cache.get("host").front().port);
+  EXPECT_EQ(6U, cache.m_queries);
+
+  // Error is reported if there are no stale records.
+
+  EXPECT_THROW(cache.get("other"), Error);
+  EXPECT_EQ(7U, cache.m_queries);
+  cache.m_fail = false;
+
+  // No records for a new host.
+
+  EXPECT_TRUE(cache.get("other").empty());
+  EXPECT_EQ(8U, cache.m_queries);
+
+  // Records with zero TTL are not cached.
+
+  cache.set_port(4);
+  cache.m_ttl = 0;
+  EXPECT_EQ(4, cache.get("zero").front().port);
+  EXPECT_EQ(4, cache.get("zero").front().port);
+  EXPECT_EQ(10U, cache.m_queries);
+}
+
+
+TEST(Foundation, srv_cache_refresh)
+{
+  Test_srv_cache cache;
+  Test_srv_cache::Srv_list seen;
+  unsigned queries = 0;
+
+  cache.set_port(1);
+  cache.get("host");
+
+  /*
+    While an entry is being refreshed, other users of the cache get
+    the current records without making another query.
+  */
+
+  cache.m_in_query = [&cache, &seen, &queries]()
+  {
+    queries = cache.m_queries;
+    seen = cache.get("host");
+    EXPECT_EQ(queries, cache.m_queries);
+  };
+
+  cache.set_port(2);
+  cache.m_now += seconds(50);
+  EXPECT_EQ(2, cache.get("host").front().port);
+  EXPECT_EQ(1, seen.front().port);
+  EXPECT_EQ(2U, cache.m_queries);
+
+  // Also when the entry has expired.
+
+  cache.set_port(3);
+  cache.m_now += seconds(100);
+  EXPECT_EQ(3, cache.get("host").front().port);
+  EXPECT_EQ(2, seen.front().port);
+  EXPECT_EQ(3U, cache.m_queries);
+}
@@ -0,0 +1,177 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2.0, as
+ * published by the Free Software Foundation.
+ *
+ * This program is also distributed with certain software (including
+ * but not limited to OpenSSL) that is licensed under separate terms,
+ * as designated in a particular file or component or in included license
+ * documentation.  The authors of MySQL hereby grant you an
+ * additional permission to link the program and your derivative works
+ * with the separately licensed software that they have included with
+ * MySQL.
+ *
+ * Without limiting anything contained in the foregoing, this file,
+ * which is part of MySQL Connector/C++, is also subject to the
+ * Universal FOSS Exception, version 1.0, a copy of which can be found at
+ * http://oss.oracle.com/licenses/universal-foss-exception.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License, version 2.0, for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin St, Fifth Floor, Boston, MA 02110-1301  USA
+ */
+
+/**
+  Unit tests for Endpoint_health and Endpoint_selector classes.
+
+  - backoff period doubling with consecutive failures, up to the maximum
+
+  - single connection attempt allowed when circuit is half-open
+
+  - second pass over endpoints skipped in the first pass
+*/
+
+#include "test.h"
+#include <mysql/cdk/foundation/endpoint_health.h>
+
+using namespace cdk::foundation;
+using std::chrono::milliseconds;
+
+
+/*
+  Endpoint_health with a clock that is moved forward explicitly.
+*/
+
+struct Test_health : public Endpoint_health
+{
+  clock::time_point m_now = clock::now();
+
+  clock::time_point now() const override
+  {
+    return m_now;
+  }
+
+  // Returns true if the endpoint is not available until `wait` passes.
+
+  bool closed_for(const std::string &endpoint, clock::duration wait)
+  {
+    m_now += wait - milliseconds(1);
+    if (available(endpoint))
+      return false;
+    m_now += milliseconds(1);
+    return available(endpoint);
+  }
+};
+
+
+TEST(Foundation, endpoint_backoff)
+{
+  Test_health health;
+
+  EXPECT_TRUE(health.available("A"));
+
+  /*
+    Each failure doubles the backoff period, starting from min_backoff,
+    until it reaches max_backoff.
+  */
+
+  auto backoff = milliseconds(Endpoint_health::min_backoff);
+
+  for (unsigned i = 0; i < 10; ++i)
+  {
+    health.report("A", false);
+    EXPECT_TRUE(health.closed_for("A", backoff)) << "failure " << i;
+
+    backoff *= 2;
+    if (backoff > Endpoint_health::max_backoff)
+      backoff = Endpoint_health::max_backoff;
+  }
+
+  EXPECT_EQ(Endpoint_health::max_backoff, backoff);
+
+  // Other endpoints are not affected.
+
+  EXPECT_TRUE(health.available("B"));
+
+  // Success closes the circuit and resets the backoff.
+
+  health.report("A", true);
+  EXPECT_TRUE(health.available("A"));
+
+  health.report("A", false);
+  EXPECT_TRUE(health.closed_for("A", Endpoint_health::min_backoff));
+}
+
+
+TEST(Foundation, endpoint_half_open)
+{
+  Test_health health;
+
+  health.report("A", false);
+  health.m_now += Endpoint_health::min_backoff;
+
+  // Only one attempt is allowed until its outcome is reported.
+
+  EXPECT_TRUE(health.available("A"));
+  EXPECT_FALSE(health.available("A"));
+  EXPECT_FALSE(health.available("A"));
+
+  // Failed probe opens the circuit again, with longer backoff.
+
+  health.report("A", false);
+  EXPECT_FALSE(health.available("A"));
+  EXPECT_TRUE(health.closed_for("A", 2*Endpoint_health::min_backoff));
+  EXPECT_FALSE(health.available("A"));
+
+  // Successful probe closes the circuit.
+
+  health.report("A", true);
+  EXPECT_TRUE(health.available("A"));
+  EXPECT_TRUE(health.available("A"));
+}
+
+
+TEST(Foundation, endpoint_selector)
+{
+  Test_health health;
+
+  health.report("B", false);
+
+  {
+    Endpoint_selector sel(health);
+
+    // First pass skips endpoint with open circuit.
+
+    EXPECT_FALSE(sel.skip("A"));
+    EXPECT_TRUE(sel.skip("B"));
+    EXPECT_FALSE(sel.skip("C"));
+
+    // Second pass tries only the skipped endpoint.
+
+    EXPECT_TRUE(sel.next_pass());
+    EXPECT_TRUE(sel.skip("A"));
+    EXPECT_FALSE(sel.skip("B"));
+    EXPECT_TRUE(sel.skip("C"));
+
+    // There is no third pass.
+
+    EXPECT_FALSE(sel.next_pass());
+  }
+
+  // No second pass if no endpoint was skipped.
+
+  {
+    Endpoint_selector sel(health);
+
+    EXPECT_FALSE(sel.skip("A"));
+    EXPECT_FALSE(sel.skip("C"));
+    EXPECT_FALSE(sel.next_pass());
+  }
+}
@@ -357,6 +357,24 @@ public:
 };
 
 
+/*
+  Exact representation of a DECIMAL value: decimal digits, most significant
+  first, and the number of these digits that are after the decimal point.
+  The value is (-1)^negative * digits * 10^(-scale). Leading zeros of
+  the integer part are not stored, except for a single 0 if needed.
+*/
+
+struct Decimal
+{
+  static const unsigned max_digits = 65;
+
+  bool     negative;
+  uint8_t  scale;
+  uint8_t  digit_count;
+  uint8_t  digits[max_digits];
+};
+
+
 template <>
 class Codec<TYPE_FLOAT>
   : Codec_base<TYPE_FLOAT>
@@ -364,8 +382,6 @@ class Codec<TYPE_FLOAT>
 
   foundation::Codec<foundation::Type::NUMBER> m_cvt;
 
-  std::string internal_decimal_to_string(bytes buf);
-
 public:
 
   Codec(const Format_info &fi) : Codec_base<TYPE_FLOAT>(fi) {}
@@ -375,6 +391,10 @@ public:
   virtual size_t from_bytes(bytes buf, float &val);
   virtual size_t from_bytes(bytes buf, double &val);
 
+  // Note: can be used only with DECIMAL format.
+
+  virtual size_t from_bytes(bytes buf, Decimal &val);
+
   virtual size_t to_bytes(float val, bytes buf);
   virtual size_t to_bytes(double val, bytes buf);
 
@@ -67,6 +67,16 @@ public:
     m_impl.close();
   }
 
+  /*
+    Returns true if rows are read from a server-side cursor and all rows
+    sent by the server so far have been read. Other statements can be
+    executed in this state, the following rows are fetched by the next
+    get_rows() call.
+  */
+
+  bool is_suspended() const
+  { return m_impl.is_suspended(); }
+
   // Meta_data interface
 
   col_count_t col_count() const
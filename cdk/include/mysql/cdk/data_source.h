@@ -38,6 +38,7 @@ PUSH_SYS_WARNINGS_CDK
 #include <algorithm>
 #include <set>
 #include <random>
+#include <vector>
 #include "api/expression.h"
 POP_SYS_WARNINGS_CDK
 
@@ -193,6 +194,27 @@ class Protocol_options
 
   virtual auth_method_t auth_method() const = 0;
 
+  /*
+    Whether messages should be compressed. With PREFERRED, compression is
+    used if the server supports one of the requested algorithms and with
+    REQUIRED connection fails otherwise.
+  */
+
+  enum compression_mode_t {
+    DISABLED,
+    PREFERRED,
+    REQUIRED
+  };
+
+  virtual compression_mode_t compression() const = 0;
+
+  /*
+    Names of compression algorithms that can be used, in the order of
+    preference. If empty, all algorithms supported by the client are tried.
+  */
+
+  virtual const std::vector<std::string>& compression_algorithms() const = 0;
+
 };
 
 
@@ -203,6 +225,8 @@ class Options
 protected:
 
   auth_method_t m_auth_method = DEFAULT;
+  compression_mode_t m_compression = DISABLED;
+  std::vector<std::string> m_compression_algorithms;
 
 public:
 
@@ -223,6 +247,26 @@ public:
     return m_auth_method;
   }
 
+  void set_compression(compression_mode_t mode)
+  {
+    m_compression = mode;
+  }
+
+  compression_mode_t compression() const
+  {
+    return m_compression;
+  }
+
+  void add_compression_algorithm(const std::string &name)
+  {
+    m_compression_algorithms.push_back(name);
+  }
+
+  const std::vector<std::string>& compression_algorithms() const
+  {
+    return m_compression_algorithms;
+  }
+
 };
 
 
@@ -594,8 +638,9 @@ namespace ds {
       DNS_SRV_source dns_srv(name, opts);
       Multi_source   src = dns_srv.get();
 
-    Note: Each call to get() issues new DNS query and can result in
-    different list of sources.
+    Note: Each call to get() can result in different list of sources.
+    DNS query results are cached for the TTL of the SRV records, so that
+    not every call issues a new query.
   */
 
   class DNS_SRV_source
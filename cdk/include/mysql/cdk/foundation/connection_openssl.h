@@ -61,6 +61,10 @@ public:
     return true;
   }
 
+  // Note: returns descriptor of the underlying plain connection.
+
+  unsigned int get_fd() const override;
+
   class Read_op;
   class Read_some_op;
   class Write_op;
@@ -200,7 +204,7 @@ private:
   unsigned int m_currentBufferIdx;
   size_t m_currentBufferOffset;
 
-  bool common_read();
+  bool common_read(bool wait);
 };
 
 
@@ -215,7 +219,7 @@ public:
 private:
   TLS& m_tls;
 
-  bool common_read();
+  bool common_read(bool wait);
 };
 
 
@@ -232,7 +236,10 @@ private:
   unsigned int m_currentBufferIdx;
   size_t m_currentBufferOffset;
 
-  bool common_write();
+  // Contents of all the buffers, if there are more than one.
+  std::vector<byte> m_coalesced;
+
+  bool common_write(bool wait);
 };
 
 
@@ -247,7 +254,7 @@ public:
 private:
   TLS& m_tls;
 
-  bool common_write();
+  bool common_write(bool wait);
 };
 
 
@@ -169,6 +169,13 @@ public:
   virtual bool is_closed() const;
   virtual unsigned int get_fd() const;
 
+  /*
+    Non-blocking check if the other end has closed the connection,
+    that is, the socket is readable but there are no bytes to read.
+  */
+
+  bool is_peer_closed() const;
+
   // Input stream
 
   bool eos() const;
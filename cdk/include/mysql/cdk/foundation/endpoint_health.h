@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2.0, as
+ * published by the Free Software Foundation.
+ *
+ * This program is also distributed with certain software (including
+ * but not limited to OpenSSL) that is licensed under separate terms,
+ * as designated in a particular file or component or in included license
+ * documentation.  The authors of MySQL hereby grant you an
+ * additional permission to link the program and your derivative works
+ * with the separately licensed software that they have included with
+ * MySQL.
+ *
+ * Without limiting anything contained in the foregoing, this file,
+ * which is part of MySQL Connector/C++, is also subject to the
+ * Universal FOSS Exception, version 1.0, a copy of which can be found at
+ * http://oss.oracle.com/licenses/universal-foss-exception.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License, version 2.0, for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin St, Fifth Floor, Boston, MA 02110-1301  USA
+ */
+
+#ifndef MYSQL_CDK_FOUNDATION_ENDPOINT_HEALTH_H
+#define MYSQL_CDK_FOUNDATION_ENDPOINT_HEALTH_H
+
+#include "common.h"
+
+PUSH_SYS_WARNINGS_CDK
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+POP_SYS_WARNINGS_CDK
+
+namespace cdk {
+namespace foundation {
+
+
+/*
+  Endpoint health tracking
+  ========================
+
+  Outcomes of connection attempts are recorded per endpoint in a process-wide
+  registry shared by all sessions. After a failed attempt the circuit of the
+  endpoint is open for a backoff period which doubles with each consecutive
+  failure (up to `max_backoff`). While the circuit is open, the endpoint is
+  skipped when connecting to one of several endpoints, unless all other
+  endpoints fail too (see Endpoint_selector). When the backoff period
+  expires, a single connection attempt is allowed (half-open circuit) and
+  its outcome either closes the circuit or opens it again with a longer
+  backoff.
+*/
+
+class Endpoint_health
+{
+public:
+
+  using clock = std::chrono::steady_clock;
+
+  static const std::chrono::milliseconds min_backoff;
+  static const std::chrono::milliseconds max_backoff;
+
+  static Endpoint_health& instance();
+
+  virtual ~Endpoint_health() {}
+
+  /*
+    Returns true if connection attempt to the given endpoint should be made
+    now. If the circuit is half-open, only the first caller gets true until
+    the outcome of its attempt is reported.
+  */
+
+  bool available(const std::string &endpoint);
+
+  void report(const std::string &endpoint, bool success);
+
+protected:
+
+  // Current time, can be overridden in tests.
+
+  virtual clock::time_point now() const
+  {
+    return clock::now();
+  }
+
+private:
+
+  struct State
+  {
+    unsigned failures = 0;
+    clock::time_point retry_at;
+    bool probing = false;
+  };
+
+  std::mutex m_lock;
+  std::map<std::string, State> m_state;
+};
+
+
+/*
+  Decides which endpoints to try when connecting to one of several
+  endpoints. In the first pass, endpoints with open circuit are skipped and
+  remembered. If no connection was established in the first pass,
+  next_pass() returns true and then only the skipped endpoints are tried.
+*/
+
+class Endpoint_selector
+{
+  Endpoint_health &m_health;
+  bool m_first_pass = true;
+  std::set<std::string> m_skipped;
+
+public:
+
+  Endpoint_selector(Endpoint_health &health = Endpoint_health::instance())
+    : m_health(health)
+  {}
+
+  // Returns true if connection attempt to the endpoint should not be made.
+
+  bool skip(const std::string &endpoint);
+
+  /*
+    Move to the second pass. Returns false if there are no skipped
+    endpoints to try, or the second pass was already done.
+  */
+
+  bool next_pass();
+};
+
+
+}}  // cdk::foundation
+
+#endif
@@ -442,10 +442,28 @@ public:
     assert(m_session);
   }
 
+  /*
+    Note: Errors from completing the reply or closing the cursor are ignored
+    because destructor must not throw.
+  */
+
   virtual ~Stmt_op()
   {
-    discard();
-    wait();
+    try {
+      discard();
+      wait();
+      // Close server-side cursor which was not read to the end.
+      if (m_suspended)
+      {
+        close_cursor();
+        wait();
+      }
+    }
+    catch (...)
+    {}
+
+    if (m_suspended && m_cursor_session)
+      m_cursor_session->m_suspended_stmts.erase(this);
     if (m_session)
       m_session->deregister_stmt(this);
   }
@@ -496,6 +514,71 @@ public:
 
   bool m_discard = false;
 
+  /*
+    Server-side cursor
+    ------------------
+
+    If set_cursor() was called before the statement is sent, its result set
+    is read through a server-side cursor with id m_cursor_id. Then server
+    sends only m_fetch_rows rows after executing the statement. If there are
+    more rows, server suspends the cursor (m_suspended is true) and the reply
+    completes as if there were no more rows. Session can be used by other
+    statements at this point.
+
+    More rows are requested with fetch_rows(). It re-registers this statement
+    with the session (m_cursor_session) as the last one and sends
+    CursorFetch command (m_cmd is FETCH). Reply to this command contains only
+    rows, so the statement goes to ROWS state after sending it. A cursor that
+    was not read to the end is closed by close_cursor() which sends
+    CursorClose command in the same way.
+
+    While suspended, the statement is kept in the session's list of
+    suspended statements. If the session is closed or reset, it drops its
+    suspended cursors (see Session::drop_cursors()): m_cursor_session is
+    cleared and m_cursor_lost is set, so that remaining rows can not be
+    fetched anymore.
+  */
+
+  uint32_t    m_cursor_id = 0;
+  row_count_t m_fetch_rows = 0;
+  bool        m_suspended = false;
+  bool        m_cursor_lost = false;
+  Session    *m_cursor_session = nullptr;
+
+  enum { STMT, FETCH, CLOSE } m_cmd = STMT;
+
+  /*
+    Request reading the result set through a server-side cursor which sends
+    fetch_rows rows at a time. Returns false if this is not possible for
+    this statement (by default only statements executed as prepared ones
+    can open a cursor), or if the statement has already been sent.
+  */
+
+  virtual bool set_cursor(row_count_t)
+  {
+    return false;
+  }
+
+  bool is_suspended() const
+  {
+    return m_suspended;
+  }
+
+  void fetch_rows(row_count_t count);
+  void close_cursor();
+
+protected:
+
+  // Allocate cursor id, to be used by set_cursor() implementations.
+
+  void open_cursor(row_count_t fetch_rows);
+
+private:
+
+  void requeue();
+
+public:
+
   /*
     This method drives asynchronous sending commands to the server. It will
     be repeatedly called until it returns true. Default implementation sends
@@ -737,6 +820,7 @@ public:
   }
 
   void done(bool eod, bool more) override;
+  void fetch_suspended() override;
 
   /*
      Stmt_processor
@@ -788,6 +872,21 @@ protected:
   bool m_limited = false;
   bool m_more_rows = false;
 
+  /*
+    When reading from a server-side cursor, m_batch_rows is the number of
+    rows of the current batch which were not read yet, and m_fetching is
+    true while waiting for the statement to send CursorFetch command for
+    the next batch.
+  */
+
+  row_count_t m_batch_rows = 0;
+  bool m_fetching = false;
+
+  bool wants_rows() const
+  {
+    return m_row_prc && m_more_rows && (!m_limited || 0 < m_rows_limit);
+  }
+
   Mdata_storage& get_mdata();
 
   const Mdata_storage& get_mdata() const
@@ -806,6 +905,18 @@ public:
 
   void close();
 
+  /*
+    Returns true if rows are read from a server-side cursor and all rows
+    sent by server so far were read. In this state session can execute other
+    statements. Remaining rows are fetched from the server on the next
+    get_rows() call.
+  */
+
+  bool is_suspended() const
+  {
+    return m_reply && m_reply->is_suspended();
+  }
+
 
   /*
     Metadata Interface
@@ -862,6 +973,7 @@ private:
   size_t col_data(col_count_t pos, bytes data);
   void   col_end(col_count_t pos, size_t data_len);
   void   done(bool eod, bool more);
+  void   fetch_suspended();
   bool message_end();
 
   void error(unsigned int code, short int severity,
@@ -39,6 +39,7 @@
 
 PUSH_SYS_WARNINGS_CDK
 #include <deque>
+#include <set>
 POP_SYS_WARNINGS_CDK
 
 #undef max
@@ -242,6 +243,27 @@ protected:
 
   Stmt_op* m_last_stmt = nullptr;
 
+  // Id of the last server-side cursor opened in this session.
+
+  uint32_t m_last_cursor_id = 0;
+
+  /*
+    Statements whose server-side cursors are currently suspended (see
+    Stmt_op). Their cursors are dropped when session is closed or reset.
+  */
+
+  std::set<Stmt_op*> m_suspended_stmts;
+
+  void drop_cursors();
+
+  /*
+    Set when a statement was executed after the last commit, rollback or
+    reset of the session. Otherwise no transaction can be open and there is
+    no need to roll it back when the session is reset.
+  */
+
+  bool m_trx_maybe_open = false;
+
   unsigned long m_id = 0;
   bool m_expired = false;
   string m_cur_schema;
@@ -257,6 +279,7 @@ public:
     : m_protocol(conn)
   {
     send_connection_attr(options);
+    negotiate_compression(options);
     authenticate(options, conn.is_secure());
     m_isvalid = true;
     // TODO: make "lazy" checks instead, deferring to the time when given
@@ -310,6 +333,28 @@ public:
   void reset();
   void close();
 
+  /*
+    Pipelining statements: after begin_pipeline(), commands of new
+    statements are not written to the server one by one. Instead, when
+    send_pipeline() is called, all pending commands are written in a single
+    write. Replies are then processed by the statements as usual.
+  */
+
+  void begin_pipeline();
+  void send_pipeline();
+
+  /*
+    Event loop integration: progress() drives pending statements without
+    blocking. It returns when further progress requires I/O that can not be
+    done now, as reported by wants_read() and wants_write(), or when no more
+    replies can be processed before a result set of the first pending
+    statement is consumed.
+  */
+
+  void progress();
+  bool wants_read() const;
+  bool wants_write();
+
   /*
     Transactions
   */
@@ -442,6 +487,8 @@ private:
 
   // Send Connection Attributes
   void send_connection_attr(const Options &options);
+  // Enable compression if requested and supported by the server
+  void negotiate_compression(const Options &options);
   // Authentication (cdk::protocol::mysqlx::Auth_processor)
   void authenticate(const Options &options, bool secure = false);
   void do_authenticate(const Options &options, int auth_method, bool secure);
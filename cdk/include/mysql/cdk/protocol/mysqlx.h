@@ -91,7 +91,8 @@ enum ClientMessages_Type {
   ClientMessages_Type_PREPARE_DEALLOCATE = 42,
   ClientMessages_Type_CURSOR_OPEN = 43,
   ClientMessages_Type_CURSOR_CLOSE = 44,
-  ClientMessages_Type_CURSOR_FETCH = 45
+  ClientMessages_Type_CURSOR_FETCH = 45,
+  ClientMessages_Type_COMPRESSION = 46
 };
 
 enum ServerMessages_Type {
@@ -107,7 +108,8 @@ enum ServerMessages_Type {
   ServerMessages_Type_RESULTSET_FETCH_SUSPENDED = 15,
   ServerMessages_Type_RESULTSET_FETCH_DONE_MORE_RESULTSETS = 16,
   ServerMessages_Type_SQL_STMT_EXECUTE_OK = 17,
-  ServerMessages_Type_RESULTSET_FETCH_DONE_MORE_OUT_PARAMS = 18
+  ServerMessages_Type_RESULTSET_FETCH_DONE_MORE_OUT_PARAMS = 18,
+  ServerMessages_Type_COMPRESSION = 19
 };
 
 
@@ -171,6 +173,7 @@ enum ServerMessages_Type {
     MSG_CLIENT(X, Mysqlx::Cursor::Open, CursorOpen, CURSOR_OPEN)\
     MSG_CLIENT(X, Mysqlx::Cursor::Close, CursorClose, CURSOR_CLOSE)\
     MSG_CLIENT(X, Mysqlx::Cursor::Fetch, CursorFetch, CURSOR_FETCH)\
+    MSG_CLIENT(X, Mysqlx::Connection::Compression, Compression, COMPRESSION)\
 \
     MSG_SERVER(X, Mysqlx::Ok, \
                Ok, OK) \
@@ -191,8 +194,8 @@ enum ServerMessages_Type {
                Row, RESULTSET_ROW) \
     MSG_SERVER(X, Mysqlx::Resultset::FetchDone, \
                FetchDone, RESULTSET_FETCH_DONE) \
-/*    MSG_SERVER(X, Mysqlx::Resultset::FetchSuspended, */ \
-/*               SqlFetchSuspended, RESULTSET_FETCH_SUSPENDED)  */ \
+    MSG_SERVER(X, Mysqlx::Resultset::FetchSuspended, \
+               FetchSuspended, RESULTSET_FETCH_SUSPENDED) \
     MSG_SERVER(X, Mysqlx::Resultset::FetchDoneMoreResultsets, \
                FetchDoneMoreResultsets, \
                RESULTSET_FETCH_DONE_MORE_RESULTSETS) \
@@ -201,6 +204,8 @@ enum ServerMessages_Type {
                RESULTSET_FETCH_DONE_MORE_OUT_PARAMS) \
     MSG_SERVER(X, Mysqlx::Sql::StmtExecuteOk, \
                StmtExecuteOk, SQL_STMT_EXECUTE_OK) \
+    MSG_SERVER(X, Mysqlx::Connection::Compression, \
+               Compression, COMPRESSION) \
 
 
 #define MSG_CLIENT(X,MSG,N,C)  MSG_CLIENT_##X(MSG,N,C)
@@ -515,6 +520,22 @@ public:
 */
 enum Data_model { DEFAULT= 0, DOCUMENT = 1, TABLE = 2 };
 
+
+/*
+  Algorithms that can be used to compress X Protocol messages. The names
+  under which the server announces them in the "compression" capability
+  are given in comments.
+*/
+
+struct compression_type
+{
+  enum value {
+    NONE = 0,
+    DEFLATE = 1,  // "deflate_stream"
+  };
+};
+
+
 class Protocol
   : foundation::opaque_impl<Protocol>
   , foundation::nocopy
@@ -527,10 +548,38 @@ public:
 
   template <class C> Protocol(C &conn);
 
+  /*
+    Messages sent after start_Pipeline() are collected and written to the
+    other end in a single write by snd_Pipeline(). Pipelines can be nested.
+    Collected messages are also written before reading a message from
+    the other end.
+  */
+
   void start_Pipeline();
   Op&  snd_Pipeline();
   void clear_Pipeline();
 
+  /*
+    Tell whether the current read (write) operation waits for the underlying
+    connection to become readable (writable). This can be used to drive
+    protocol operations with cont() from an event loop.
+  */
+
+  bool wants_read() const;
+  bool wants_write() const;
+
+  /**
+    Start compressing messages using the given algorithm, which should be
+    first negotiated with the server. Outgoing messages whose frames are at
+    least `threshold` bytes long are sent inside Compression frames and
+    incoming Compression frames are transparently decompressed. Setting
+    compression_type::NONE disables compression.
+
+    Throws error if the algorithm is not supported by this build.
+  */
+
+  void set_compression(compression_type::value, size_t threshold = 1000);
+
   Op& snd_CapabilitiesSet(const api::Any::Document& caps);
   Op& snd_AuthenticateStart(const char* mechanism, bytes data, bytes response);
   Op& snd_AuthenticateContinue(bytes data);
@@ -576,10 +625,17 @@ public:
 
     @param args  if expressions used in the specification use named parameters,
       this argument map provides values of these parameters
+
+    @param cursor_id  if not 0 and the statement is prepared (stmt_id is not 0),
+      the prepared statement is executed by opening a server-side cursor with
+      this id (@see snd_CursorOpen())
+
+    @param fetch_rows  number of rows sent by server after opening the cursor
   */
 
   Op& snd_Find(Data_model dm, uint32_t stmt_id, const Find_spec &spec,
-               const api::Args_map *args = nullptr);
+               const api::Args_map *args = nullptr,
+               uint32_t cursor_id = 0, row_count_t fetch_rows = 0);
 
   /**
     Send CRUD Insert command.
@@ -684,6 +740,35 @@ public:
   Op& snd_PrepareExecute(uint32_t stmt_id,
                          const api::Any_list *args = nullptr);
 
+  /**
+    Send CursorOpen command.
+
+    This command executes a prepared CRUD statement (with parameters and
+    limits as for snd_PrepareExecute()) and opens a server-side cursor with
+    the given id for reading its result set. The server replies with
+    the result set meta-data followed by at most `fetch_rows` rows (all rows
+    if `fetch_rows` is 0). If not all rows were sent, the row sequence ends
+    with FetchSuspended message instead of FetchDone (which is reported as
+    Row_processor::fetch_suspended()). In either case the reply ends with
+    StmtExecuteOk.
+
+    Remaining rows are requested with snd_CursorFetch(). The reply to it is
+    a sequence of rows without meta-data, ended in the same way as above,
+    which should be read with rcv_Rows() followed by rcv_StmtReply().
+
+    Cursor which was not read to the end should be closed with
+    snd_CursorClose(), to which server replies with OK (rcv_Reply()).
+  */
+
+  Op& snd_CursorOpen(uint32_t cursor_id, uint32_t stmt_id,
+                     const api::Limit *limit,
+                     const api::Args_map *args,
+                     row_count_t fetch_rows = 0);
+
+  Op& snd_CursorFetch(uint32_t cursor_id, row_count_t fetch_rows = 0);
+
+  Op& snd_CursorClose(uint32_t cursor_id);
+
   /**
     Send PrepareDeallocate command.
 
@@ -772,7 +857,9 @@ private:
   implementations. If C is a connection class then an object of class
   Protocol::Stream::Impl<C> implements methods read() and write() which
   create read or write operation, respectively, using appropriate operation
-  type C::Read_op or C::Write_op. This operation is allocated dynamically
+  type C::Read_op or C::Write_op. Method read_some() creates operation of
+  type C::Read_some_op which completes as soon as some bytes are available,
+  without filling the whole buffer. This operation is allocated dynamically
   and should be deleted by the caller of the method.
 */
 
@@ -788,6 +875,7 @@ public:
   {}
 
   virtual Op* read(const buffers&) =0;
+  virtual Op* read_some(const buffers&) =0;
   virtual Op* write(const buffers&) =0;
 
 private:
@@ -808,6 +896,7 @@ template <class C>
 class Protocol::Stream::Impl : public Stream
 {
   typedef typename C::Read_op  Rd_op;
+  typedef typename C::Read_some_op  Rd_some_op;
   typedef typename C::Write_op Wr_op;
 
   C &m_conn;
@@ -817,6 +906,9 @@ class Protocol::Stream::Impl : public Stream
   Op* read(const buffers &buf)
   { return new Rd_op(m_conn, buf); }
 
+  Op* read_some(const buffers &buf)
+  { return new Rd_some_op(m_conn, buf); }
+
   Op* write(const buffers &buf)
   { return new Wr_op(m_conn, buf); }
 
@@ -1083,6 +1175,16 @@ public:
   */
 
   virtual void done(bool /*eod*/, bool /*more*/) {}
+
+  /*
+    Called instead of done() when rows are read from a server-side cursor
+    and the server has sent all rows requested by the last cursor open or
+    fetch command, but the result set has more rows. These can be requested
+    with snd_CursorFetch(). The final StmtExecuteOk packet, which follows,
+    should be read with rcv_StmtReply().
+  */
+
+  virtual void fetch_suspended() {}
 };
 
 class Mdata_processor : public Reply_processor
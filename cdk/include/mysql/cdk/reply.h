@@ -93,6 +93,20 @@ public:
   { return m_impl->generated_ids(); }
   void discard() { m_impl->discard(); }
 
+  /*
+    Request that the result set is read through a server-side cursor which
+    sends fetch_rows rows at a time (all rows if 0). This must be called
+    before the reply is processed and is possible only if the statement is
+    executed as a prepared one. Returns false if the cursor can not be used.
+  */
+
+  bool use_cursor(row_count_t fetch_rows)
+  { return m_impl->set_cursor(fetch_rows); }
+
+  // Returns true if command(s) of the statement were already sent.
+
+  bool stmt_sent() { return m_impl->stmt_sent(); }
+
   // Diagnostics interface
 
   unsigned int entry_count(Severity::value level=Severity::ERROR)
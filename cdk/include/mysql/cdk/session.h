@@ -55,7 +55,7 @@ class Session
 protected:
   mysqlx::Session      *m_session;
   const mysqlx::string *m_database;
-  api::Connection      *m_connection;
+  foundation::connection::Socket_base *m_connection;
 
   typedef Reply::Initializer Reply_init;
 
@@ -68,6 +68,12 @@ public:
   Session(ds::TCPIP &ds,
           const ds::TCPIP::Options &options = ds::TCPIP::Options());
 
+  /*
+    Create session to one of the data stores in the list, trying them in
+    the order determined by the list. Endpoints to which recent connection
+    attempts have failed are tried only after all other endpoints.
+  */
+
   Session(ds::Multi_source&);
 
 #ifndef _WIN32
@@ -80,7 +86,19 @@ public:
   // Core Session operations.
 
   option_t is_valid() { return m_session->is_valid(); }
-  option_t check_valid() { return m_session->check_valid(); }
+
+  /*
+    Besides the local checks of is_valid(), detect (without blocking)
+    that the server has closed the connection.
+  */
+
+  option_t check_valid()
+  {
+    option_t valid = m_session->check_valid();
+    if (option_t::YES == valid.state() && m_connection->is_peer_closed())
+      return false;
+    return valid;
+  }
 
   option_t has_prepared_statements() {
     return m_session->has_prepared_statements();
@@ -99,6 +117,41 @@ public:
     m_connection->close();
   }
 
+  void begin_pipeline() {
+    m_session->begin_pipeline();
+  }
+
+  void send_pipeline() {
+    m_session->send_pipeline();
+  }
+
+  /*
+    Event loop integration
+    ----------------------
+
+    The socket used by the session can be watched by an external event loop.
+    Whenever it becomes ready for the I/O reported by wants_read() or
+    wants_write(), progress() should be called to drive pending statements
+    without blocking. The interest set should be checked again after each
+    progress() call.
+  */
+
+  unsigned get_fd() const {
+    return m_connection->get_fd();
+  }
+
+  bool wants_read() const {
+    return m_session->wants_read();
+  }
+
+  bool wants_write() {
+    return m_session->wants_write();
+  }
+
+  void progress() {
+    m_session->progress();
+  }
+
   /*
     Transactions
     ------------
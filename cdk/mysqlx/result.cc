@@ -41,7 +41,17 @@ bool Stmt_op::do_send()
 {
   if (!m_op)
   {
-    m_op = send_cmd();
+    switch (m_cmd)
+    {
+    case FETCH:
+      m_op = &get_protocol().snd_CursorFetch(m_cursor_id, m_fetch_rows);
+      break;
+    case CLOSE:
+      m_op = &get_protocol().snd_CursorClose(m_cursor_id);
+      break;
+    default:
+      m_op = send_cmd();
+    }
     // note: after returning true, this is never called again
     if (!m_op)
     {
@@ -96,7 +106,10 @@ bool Stmt_op::do_cont()
 
         if (DONE == m_state || ERROR == m_state)
           return true;
-        m_state = OK;
+
+        // Reply to CursorFetch contains only rows of the result set.
+
+        m_state = (FETCH == m_cmd) ? ROWS : OK;
       }
       return false;
     }
@@ -260,6 +273,74 @@ void Stmt_op::done(bool eod, bool more)
   m_state = more ? (m_discard ? MDATA : NEXT) : FINISH;
 }
 
+void Stmt_op::fetch_suspended()
+{
+  // Note: server sends final StmtExecuteOk after suspending the cursor.
+  m_suspended = true;
+  m_state = FINISH;
+  m_cursor_session->m_suspended_stmts.insert(this);
+}
+
+
+void Stmt_op::open_cursor(row_count_t fetch_rows)
+{
+  assert(WAIT == m_state);
+  m_cursor_session = &get_session();
+  m_cursor_id = ++m_cursor_session->m_last_cursor_id;
+  m_fetch_rows = fetch_rows;
+}
+
+
+void Stmt_op::fetch_rows(row_count_t count)
+{
+  assert(m_suspended);
+
+  // Complete reading reply to the previous cursor command.
+
+  wait();
+  if (ERROR == m_state)
+    return;
+
+  m_fetch_rows = count;
+  m_cmd = FETCH;
+  requeue();
+}
+
+
+void Stmt_op::close_cursor()
+{
+  if (!m_suspended)
+    return;
+
+  wait();
+  if (ERROR == m_state)
+    return;
+
+  m_cmd = CLOSE;
+  requeue();
+}
+
+
+/*
+  Register this statement with its session again, as the last one, so that
+  another command for the server-side cursor can be sent after commands of
+  other statements which were issued in the meantime.
+*/
+
+void Stmt_op::requeue()
+{
+  assert(DONE == m_state && !m_op);
+  assert(m_cursor_session);
+
+  if (m_session)
+    m_session->deregister_stmt(this);
+  m_cursor_session->m_suspended_stmts.erase(this);
+  m_cursor_session->register_stmt(this);
+
+  m_suspended = false;
+  m_state = WAIT;
+}
+
 
 void Stmt_op::discard_result()
 {
@@ -543,6 +624,7 @@ Cursor::Cursor(const std::shared_ptr<Stmt_op> &reply)
   }
 
   m_more_rows = true;
+  m_batch_rows = m_reply->m_fetch_rows;
   m_reply->m_current_cursor = this;
 }
 
@@ -566,8 +648,7 @@ void Cursor::internal_get_rows(mysqlx::Row_processor& rp)
     throw_error("get_rows: Closed cursor");
 
   // wait previous get_rows();
-  if (m_rows_op)
-    m_rows_op->wait();
+  wait();
 
   if (!m_more_rows)
   {
@@ -578,8 +659,27 @@ void Cursor::internal_get_rows(mysqlx::Row_processor& rp)
   }
 
   m_more_rows = true;
-  m_rows_op = &m_reply->get_protocol().rcv_Rows(*this);
   m_row_prc = &rp;
+
+  /*
+    If server-side cursor is suspended, rows are fetched when this operation
+    is continued (see do_cont()).
+  */
+
+  if (is_suspended())
+  {
+    m_rows_op = nullptr;
+    return;
+  }
+
+  if (m_reply->m_cursor_lost)
+  {
+    m_more_rows = false;
+    throw_error("get_rows: Server-side cursor was closed by session close"
+                " or reset");
+  }
+
+  m_rows_op = &m_reply->get_protocol().rcv_Rows(*this);
 }
 
 
@@ -614,6 +714,10 @@ void Cursor::close()
       m_rows_op->wait();
     m_rows_op = nullptr;
 
+    if (m_fetching)
+      m_reply->wait();
+    m_fetching = false;
+
     /*
       Discard remaining rows in the result set so that if there is another
       result set in the reply, it will become accessible (for example, if
@@ -622,6 +726,17 @@ void Cursor::close()
 
     m_reply->m_current_cursor = nullptr;
     m_reply->discard_result();
+
+    /*
+      For a server-side cursor this discards only the remaining rows of the
+      current batch. If the cursor is suspended after that, it is closed.
+    */
+
+    if (m_reply->m_cursor_id)
+    {
+      m_reply->wait();
+      m_reply->close_cursor();
+    }
   }
 
   m_reply.reset();
@@ -710,10 +825,21 @@ bool Cursor::is_completed() const
   if (m_init) //m_reply && !m_reply->is_completed())
     return false;
 
-  if (!m_rows_op)
-    return true;
+  if (m_fetching)
+    return false;
+
+  if (m_rows_op && !m_rows_op->is_completed())
+    return false;
+
+  /*
+    If server-side cursor is suspended, we are done when the reply is
+    completely read, unless more rows were requested and need to be fetched.
+  */
+
+  if (is_suspended())
+    return !wants_rows() && m_reply->is_completed();
 
-  return m_rows_op->is_completed();
+  return true;
 }
 
 
@@ -728,8 +854,47 @@ bool Cursor::do_cont()
       m_reply->wait();
   }
 
-  if (m_rows_op)
-    m_rows_op->cont();
+  if (m_rows_op && !m_rows_op->cont())
+    return false;
+
+  if (m_fetching)
+  {
+    // Wait until CursorFetch is sent, then read rows from its reply.
+
+    if (!m_reply->cont())
+      return false;
+
+    m_fetching = false;
+
+    if (Stmt_op::ERROR == m_reply->m_state)
+    {
+      m_more_rows = false;
+      return true;
+    }
+
+    m_rows_op = &m_reply->get_protocol().rcv_Rows(*this);
+    return false;
+  }
+
+  if (is_suspended())
+  {
+    /*
+      Server-side cursor is suspended: complete reading the reply (so that
+      session can be used by other statements) and then, if more rows are
+      requested, fetch the next batch.
+    */
+
+    if (!m_reply->cont())
+      return false;
+
+    if (!wants_rows())
+      return true;
+
+    m_reply->fetch_rows(m_limited ? m_rows_limit : 0);
+    m_batch_rows = m_reply->m_fetch_rows;
+    m_fetching = true;
+    return false;
+  }
 
   return is_completed();
 }
@@ -742,14 +907,12 @@ void Cursor::do_wait()
   //if (m_closed)
   //  throw_error("wait: Closed cursor");
 
-  if (m_init && m_reply)
-    m_reply->wait();
-  m_init = false;
-
-  if (m_rows_op)
+  while (!do_cont())
   {
-    m_rows_op->wait();
-    assert(is_completed());
+    if (m_rows_op)
+      m_rows_op->wait();
+    else if (m_reply)
+      m_reply->wait();
   }
 }
 
@@ -791,6 +954,9 @@ void Cursor::row_end(row_count_t row)
     if (m_limited)
       --m_rows_limit;
   }
+
+  if (0 < m_batch_rows)
+    --m_batch_rows;
 }
 
 
@@ -844,6 +1010,15 @@ void Cursor::done(bool eod, bool more)
     m_reply->done(eod, more);
 }
 
+
+void Cursor::fetch_suspended()
+{
+  m_rows_op = nullptr;
+
+  if (m_reply)
+    m_reply->fetch_suspended();
+}
+
 /*
   FIXME: The logic to call done(false, false) when all requested rows
   have been read could/should be implemented somewhere on the protocol
@@ -857,6 +1032,16 @@ bool Cursor::message_end()
   if (!m_limited || 0 < m_rows_limit)
     return true;
 
+  /*
+    If the last row of a batch sent by a server-side cursor was read, we
+    continue to the message which ends the batch. This way the cursor gets
+    suspended and the session is not blocked by the unread reply.
+  */
+
+  if (m_reply && m_reply->m_cursor_id && 0 < m_reply->m_fetch_rows
+      && 0 == m_batch_rows)
+    return true;
+
   done(false, false);
   return false;
 }
@@ -31,9 +31,12 @@
 #include <mysql/cdk/foundation.h>
 #include <mysql/cdk/mysqlx.h>
 #include <mysql/cdk/protocol/mysqlx.h>
+#include <mysql/cdk/config.h>
 
 PUSH_SYS_WARNINGS_CDK
 #include <iostream>
+#include <algorithm>
+#include <cctype>
 #include "auth_hash.h"
 POP_SYS_WARNINGS_CDK
 
@@ -463,6 +466,28 @@ public:
    Class Session
 */
 
+/*
+  Reply processor which stores error reported by the server, if any.
+*/
+
+struct Check_reply_prc : cdk::protocol::mysqlx::Reply_processor
+{
+  string m_msg;
+  unsigned int m_code = 0;
+  cdk::protocol::mysqlx::sql_state_t m_sql_state;
+  void error(unsigned int code, short int,
+             cdk::protocol::mysqlx::sql_state_t state, const string &msg) override
+  {
+    m_code = code;
+    m_sql_state = state;
+    m_msg = msg;
+  }
+
+  void ok(string) override
+  {}
+};
+
+
 void Session::send_connection_attr(const Options &options)
 {
 
@@ -499,23 +524,6 @@ void Session::send_connection_attr(const Options &options)
   {
     m_protocol.snd_CapabilitiesSet(Attr_converter(options.attributes())).wait();
 
-    struct Check_reply_prc : cdk::protocol::mysqlx::Reply_processor
-    {
-      string m_msg;
-      unsigned int m_code = 0;
-      cdk::protocol::mysqlx::sql_state_t m_sql_state;
-      void error(unsigned int code, short int,
-                 cdk::protocol::mysqlx::sql_state_t state, const string &msg) override
-      {
-        m_code = code;
-        m_sql_state = state;
-        m_msg = msg;
-      }
-
-      void ok(string) override
-      {}
-    };
-
     Check_reply_prc prc;
 
     m_protocol.rcv_Reply(prc).wait();
@@ -531,6 +539,96 @@ void Session::send_connection_attr(const Options &options)
 }
 
 
+/*
+  Map name of compression algorithm, as used by the "compression"
+  capability, to the algorithm supported by the protocol layer. Returns
+  compression_type::NONE if given algorithm is not supported by this build.
+*/
+
+static
+cdk::protocol::mysqlx::compression_type::value
+compression_algorithm(std::string name)
+{
+  using cdk::protocol::mysqlx::compression_type;
+
+  std::transform(name.begin(), name.end(), name.begin(), ::tolower);
+
+#ifdef HAVE_ZLIB
+  if ("deflate_stream" == name || "deflate" == name)
+    return compression_type::DEFLATE;
+#endif
+
+  return compression_type::NONE;
+}
+
+
+/*
+  Try compression algorithms listed in the options, in order, until
+  the server accepts one of them. Compression is enabled in the protocol
+  only after the server confirms the choice.
+*/
+
+void Session::negotiate_compression(const Options &options)
+{
+  using cdk::ds::mysqlx::Protocol_options;
+  using cdk::protocol::mysqlx::compression_type;
+
+  if (Protocol_options::DISABLED == options.compression())
+    return;
+
+  struct Compression_caps
+      : cdk::protocol::mysqlx::api::Any::Document
+  {
+    const std::string &m_name;
+
+    Compression_caps(const std::string &name)
+      : m_name(name)
+    {}
+
+    void process(Processor &prc) const override
+    {
+      prc.doc_begin();
+      auto *compr_prc = prc.key_val("compression")->doc();
+      compr_prc->doc_begin();
+      compr_prc->key_val("algorithm")->scalar()->str(bytes(m_name));
+      compr_prc->doc_end();
+      prc.doc_end();
+    }
+  };
+
+  static const std::vector<std::string> default_algorithms{ "deflate_stream" };
+
+  const std::vector<std::string> &algorithms
+    = options.compression_algorithms().empty()
+    ? default_algorithms : options.compression_algorithms();
+
+  for (const std::string &name : algorithms)
+  {
+    compression_type::value algorithm = compression_algorithm(name);
+
+    if (compression_type::NONE == algorithm)
+      continue;
+
+    m_protocol.snd_CapabilitiesSet(Compression_caps(name)).wait();
+
+    Check_reply_prc prc;
+    m_protocol.rcv_Reply(prc).wait();
+
+    if (0 == prc.m_code)
+    {
+      m_protocol.set_compression(algorithm);
+      return;
+    }
+  }
+
+  if (Protocol_options::REQUIRED == options.compression())
+    throw_error(
+      "Compression requested but the server does not support"
+      " any of the requested algorithms"
+    );
+}
+
+
 void Session::do_authenticate(const Options &options,
                               int original_am,
                               bool  secure_conn)
@@ -659,32 +757,6 @@ option_t Session::check_valid()
   return  is_valid() ? true : false;
 }
 
-void Session::reset()
-{
-  clean_up();
-
-  if (is_valid())
-  {
-    // TODO: Do it in asnyc fashion using the fact that session is an
-    // async operation
-
-    m_protocol.snd_SessionReset(has_keep_open()).wait();
-    m_protocol.rcv_Reply(*this).wait();
-
-    if (!has_keep_open())
-    {
-      // Re-authenticate for servers not supporting keep-open
-      m_isvalid = false;
-      clear_errors();
-      m_auth->restart();
-      m_auth->wait();
-      if (entry_count())
-        get_error().rethrow();
-      m_isvalid = m_auth->get_result();
-    }
-  }
-}
-
 
 /*
   Discard results for the given statement and all previous statements
@@ -702,18 +774,149 @@ void discard_results(Stmt_op *stmt)
 }
 
 
+void Session::reset()
+{
+  if (!is_valid())
+    return;
+
+  discard_results(m_last_stmt);
+  clear_errors();
+  drop_cursors();
+
+  /*
+    Rollback of the open transaction (if there can be one) and session reset
+    requests are sent to the server in a single pipelined write. Then replies
+    to both are processed.
+  */
+
+  std::unique_ptr<Stmt_op> rollback_op;
+  bool keep_open = has_keep_open();
+
+  m_protocol.start_Pipeline();
+
+  try {
+    if (m_trx_maybe_open)
+    {
+      rollback_op.reset(sql(0, "ROLLBACK", nullptr));
+      while (!rollback_op->stmt_sent())
+        rollback_op->cont();
+    }
+    m_protocol.snd_SessionReset(keep_open).wait();
+  }
+  catch (...)
+  {
+    m_protocol.clear_Pipeline();
+    throw;
+  }
+
+  m_protocol.snd_Pipeline().wait();
+
+  if (rollback_op)
+    rollback_op->wait();
+
+  m_protocol.rcv_Reply(*this).wait();
+
+  if (rollback_op && rollback_op->entry_count() > 0)
+    rollback_op->get_error().rethrow();
+
+  m_trx_maybe_open = false;
+
+  if (!keep_open)
+  {
+    // Re-authenticate for servers not supporting keep-open
+    m_isvalid = false;
+    clear_errors();
+    m_auth->restart();
+    m_auth->wait();
+    if (entry_count())
+      get_error().rethrow();
+    m_isvalid = m_auth->get_result();
+  }
+}
+
+
 void Session::clean_up()
 {
   if (!is_valid())
     return;
   discard_results(m_last_stmt);
-  rollback({});
+  if (m_trx_maybe_open)
+    rollback({});
   clear_errors();
 }
 
 
+void Session::begin_pipeline()
+{
+  m_protocol.start_Pipeline();
+}
+
+
+void Session::send_pipeline()
+{
+  /*
+    Driving the last statement makes all statements before it send their
+    commands first.
+  */
+
+  try {
+    while (m_last_stmt && !m_last_stmt->stmt_sent())
+      m_last_stmt->cont();
+  }
+  catch (...)
+  {
+    m_protocol.snd_Pipeline().wait();
+    throw;
+  }
+
+  m_protocol.snd_Pipeline().wait();
+}
+
+
+void Session::progress()
+{
+  while (m_last_stmt && !m_last_stmt->cont())
+  {
+    if (wants_read() || wants_write())
+      return;
+
+    /*
+      If the first pending statement is completed but still in the queue,
+      replies to the following statements are blocked by its result set.
+    */
+
+    Stmt_op *first = m_last_stmt;
+    while (first->m_prev_stmt)
+      first = first->m_prev_stmt;
+
+    if (first != m_last_stmt && first->is_completed())
+      return;
+  }
+}
+
+
+bool Session::wants_read() const
+{
+  return m_protocol.wants_read();
+}
+
+
+/*
+  Note: A statement which has not sent its command yet needs to write to
+  the connection.
+*/
+
+bool Session::wants_write()
+{
+  return m_protocol.wants_write()
+    || (m_last_stmt && !m_last_stmt->stmt_sent());
+}
+
+
 void Session::close()
 {
+  drop_cursors();
+
   if (is_valid())
   try {
     clean_up();
@@ -729,6 +932,25 @@ void Session::close()
 }
 
 
+/*
+  Server-side cursors do not survive session close or reset. Statements
+  with suspended cursors are detached from this session so that they do not
+  use it anymore.
+*/
+
+void Session::drop_cursors()
+{
+  for (Stmt_op *stmt : m_suspended_stmts)
+  {
+    stmt->m_suspended = false;
+    stmt->m_cursor_lost = true;
+    stmt->m_cursor_session = nullptr;
+  }
+
+  m_suspended_stmts.clear();
+}
+
+
 /*
   Statements registered with a session are put into a double linked
   list, with stmt->m_prev_stmt pointing at the previous statement that
@@ -743,6 +965,7 @@ void Session::register_stmt(Stmt_op *stmt)
   assert(!stmt->m_session);
 
   stmt->m_session = this;
+  m_trx_maybe_open = true;
 
   // Append stmt to the end of the list of active statements.
 
@@ -819,6 +1042,7 @@ void Session::commit()
   op->wait();
   if (op->entry_count() > 0)
     op->get_error().rethrow();
+  m_trx_maybe_open = false;
 }
 
 void Session::rollback(const string &savepoint)
@@ -830,6 +1054,8 @@ void Session::rollback(const string &savepoint)
   op->wait();
   if (op->entry_count() > 0)
     op->get_error().rethrow();
+  if (savepoint.empty())
+    m_trx_maybe_open = false;
 }
 
 void Session::savepoint_set(const string &savepoint)
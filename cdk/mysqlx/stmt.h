@@ -65,7 +65,7 @@ protected:
       reply instead of simple OK.
     */
 
-    if (OK == m_state)
+    if (OK == m_state && STMT == m_cmd)
       m_state = MDATA;
 
     assert(OK != m_state);
@@ -117,6 +117,7 @@ protected:
   Any_list_converter m_list_conv;
   Param_converter    m_map_conv;
   bool m_prepare_error = false;
+  bool m_list_args = false;
 
 public:
 
@@ -144,6 +145,7 @@ public:
   )
     : Base(s)
     , m_stmt_id(stmt_id)
+    , m_list_args(true)
   {
     if (list)
     {
@@ -168,6 +170,12 @@ public:
   {
     uint32_t id = m_stmt_id;
     m_stmt_id = 0;  // so that we directly process reply to Execute
+    if (Base::m_cursor_id)
+    {
+      return &Base::get_protocol().snd_CursorOpen(
+        Base::m_cursor_id, id, m_limit, m_param_map, Base::m_fetch_rows
+      );
+    }
     if (m_limit || m_param_map)
     {
       return &Base::get_protocol().snd_PrepareExecute(id, m_limit, m_param_map);
@@ -178,6 +186,21 @@ public:
     }
   }
 
+  /*
+    Only execution of a prepared statement can open a server-side cursor.
+    Derived classes that send prepare + execute pipeline should open the
+    cursor if Base::m_cursor_id is set. Statements with parameters given
+    as a list are not supported.
+  */
+
+  bool set_cursor(row_count_t fetch_rows) override
+  {
+    if (0 == m_stmt_id || m_list_args || Base::WAIT != Base::m_state)
+      return false;
+    Base::open_cursor(fetch_rows);
+    return true;
+  }
+
   bool do_cont() override
   {
     /*
@@ -730,7 +753,8 @@ protected:
 
   Proto_op* send_cmd() override
   {
-    return &get_protocol().snd_Find(DM, m_stmt_id, *this, m_param_map);
+    return &get_protocol().snd_Find(DM, m_stmt_id, *this, m_param_map,
+                                    m_cursor_id, m_fetch_rows);
   }
 
 public:
@@ -0,0 +1,206 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2.0, as
+ * published by the Free Software Foundation.
+ *
+ * This program is also distributed with certain software (including
+ * but not limited to OpenSSL) that is licensed under separate terms,
+ * as designated in a particular file or component or in included license
+ * documentation.  The authors of MySQL hereby grant you an
+ * additional permission to link the program and your derivative works
+ * with the separately licensed software that they have included with
+ * MySQL.
+ *
+ * Without limiting anything contained in the foregoing, this file,
+ * which is part of MySQL Connector/C++, is also subject to the
+ * Universal FOSS Exception, version 1.0, a copy of which can be found at
+ * http://oss.oracle.com/licenses/universal-foss-exception.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License, version 2.0, for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin St, Fifth Floor, Boston, MA 02110-1301  USA
+ */
+
+/*
+  Implementation of X Protocol compression algorithms
+  ===================================================
+*/
+
+#include <mysql/cdk/foundation/common.h>
+#include <mysql/cdk/config.h>
+#include "compression.h"
+
+PUSH_SYS_WARNINGS_CDK
+#include <algorithm>  // std::min
+POP_SYS_WARNINGS_CDK
+
+#ifdef HAVE_ZLIB
+PUSH_SYS_WARNINGS_CDK
+#include <zlib.h>
+POP_SYS_WARNINGS_CDK
+#endif
+
+
+using namespace cdk::foundation;
+using namespace cdk::protocol::mysqlx;
+
+
+#ifdef HAVE_ZLIB
+
+/*
+  The "deflate_stream" algorithm: single deflate stream for each direction
+  of the connection. Each compressed chunk ends with a sync flush so that
+  the other side can decompress it without waiting for more data.
+*/
+
+class Compression_zlib : public Compression
+{
+  z_stream m_def;
+  z_stream m_inf;
+
+  /*
+    Size by which output buffer is extended when compressed or decompressed
+    data does not fit into it.
+  */
+
+  static const size_t chunk_size = 16*1024;
+
+public:
+
+  Compression_zlib()
+  {
+    memset(&m_def, 0, sizeof(m_def));
+    memset(&m_inf, 0, sizeof(m_inf));
+
+    if (Z_OK != deflateInit(&m_def, Z_DEFAULT_COMPRESSION))
+      throw_error("Could not initialize compression stream");
+
+    if (Z_OK != inflateInit(&m_inf))
+    {
+      deflateEnd(&m_def);
+      throw_error("Could not initialize decompression stream");
+    }
+  }
+
+  ~Compression_zlib()
+  {
+    deflateEnd(&m_def);
+    inflateEnd(&m_inf);
+  }
+
+  void compress(bytes data, std::string &out) override
+  {
+    out.clear();
+
+    m_def.next_in = (Bytef*)data.begin();
+    m_def.avail_in = (uInt)data.size();
+
+    // Deflate until all pending output is flushed, which is the case when
+    // deflate() does not fill the whole output space given to it.
+
+    do {
+      // Normally the first chunk is big enough for all the output: the bound
+      // is extended by a few bytes needed for the sync flush marker.
+
+      size_t pos = out.size();
+      size_t space = (0 == pos ?
+        (size_t)deflateBound(&m_def, (uLong)data.size()) + 16 : chunk_size);
+      out.resize(pos + space);
+
+      m_def.next_out = (Bytef*)&out[pos];
+      m_def.avail_out = (uInt)space;
+
+      int rc = deflate(&m_def, Z_SYNC_FLUSH);
+      out.resize(pos + space - m_def.avail_out);
+
+      if (Z_OK != rc && Z_BUF_ERROR != rc)
+        throw_error("Could not compress data");
+
+    } while (0 == m_def.avail_out);
+  }
+
+  void uncompress(bytes data, size_t size, size_t max_size,
+                  std::string &out) override
+  {
+    out.clear();
+
+    if (size > max_size)
+      throw_error("Decompressed data is too big");
+
+    m_inf.next_in = (Bytef*)data.begin();
+    m_inf.avail_in = (uInt)data.size();
+
+    // Decompressed data can not be longer than this.
+
+    size_t limit = (size > 0 ? size : max_size);
+
+    do {
+      // If the expected size is known, the first chunk has one byte more
+      // so that inflate() does not fill it completely when all data fits.
+      // Output space is never extended beyond limit + 1 bytes, which is
+      // enough to detect data that is too long.
+
+      size_t pos = out.size();
+
+      if (pos > limit)
+        throw_error(size > 0 ?
+          "Decompressed data has wrong size" : "Decompressed data is too big"
+        );
+
+      size_t space = (0 == pos && size > 0 ? size + 1 : chunk_size);
+      space = std::min(space, limit + 1 - pos);
+      out.resize(pos + space);
+
+      m_inf.next_out = (Bytef*)&out[pos];
+      m_inf.avail_out = (uInt)space;
+
+      int rc = inflate(&m_inf, Z_SYNC_FLUSH);
+      out.resize(pos + space - m_inf.avail_out);
+
+      if (Z_BUF_ERROR == rc)
+        break;
+
+      // The other side should never end the stream, but if it does, next
+      // data starts a new one.
+
+      if (Z_STREAM_END == rc)
+      {
+        inflateReset(&m_inf);
+        continue;
+      }
+
+      if (Z_OK != rc)
+        throw_error("Could not decompress data");
+
+    } while (0 == m_inf.avail_out || 0 < m_inf.avail_in);
+
+    if (out.size() > limit || (size > 0 && out.size() != size))
+      throw_error(size > 0 ?
+        "Decompressed data has wrong size" : "Decompressed data is too big"
+      );
+  }
+
+};
+
+#endif
+
+
+Compression* Compression::create(compression_type::value algorithm)
+{
+  switch (algorithm)
+  {
+#ifdef HAVE_ZLIB
+  case compression_type::DEFLATE: return new Compression_zlib();
+#endif
+  default:
+    throw_error("Compression algorithm is not supported");
+  }
+  return nullptr;  // quiet compiler warnings
+}
@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2.0, as
+ * published by the Free Software Foundation.
+ *
+ * This program is also distributed with certain software (including
+ * but not limited to OpenSSL) that is licensed under separate terms,
+ * as designated in a particular file or component or in included license
+ * documentation.  The authors of MySQL hereby grant you an
+ * additional permission to link the program and your derivative works
+ * with the separately licensed software that they have included with
+ * MySQL.
+ *
+ * Without limiting anything contained in the foregoing, this file,
+ * which is part of MySQL Connector/C++, is also subject to the
+ * Universal FOSS Exception, version 1.0, a copy of which can be found at
+ * http://oss.oracle.com/licenses/universal-foss-exception.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License, version 2.0, for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin St, Fifth Floor, Boston, MA 02110-1301  USA
+ */
+
+#ifndef PROTOCOL_MYSQLX_COMPRESSION_H
+#define PROTOCOL_MYSQLX_COMPRESSION_H
+
+#include <mysql/cdk/protocol/mysqlx.h>
+
+PUSH_SYS_WARNINGS_CDK
+#include <string>
+POP_SYS_WARNINGS_CDK
+
+
+namespace cdk {
+namespace protocol {
+namespace mysqlx {
+
+
+/*
+  Compression algorithm used for X Protocol compression.
+
+  An instance keeps compression and decompression contexts for one
+  connection. The contexts live as long as the connection because the
+  algorithms work on a stream: data compressed by the other end can refer
+  to data from its previous Compression frames.
+
+  Method compress() replaces contents of `out` with compressed data. Method
+  uncompress() replaces contents of `out` with decompressed data. If `size`
+  is not 0, it is the declared size of decompressed data and error is thrown
+  if the actual size differs. Otherwise error is thrown if decompressed data
+  is longer than `max_size`. In both cases memory already allocated for `out`
+  is re-used.
+*/
+
+class Compression
+{
+public:
+
+  virtual ~Compression() {}
+
+  virtual void compress(bytes data, std::string &out) = 0;
+  virtual void uncompress(bytes data, size_t size, size_t max_size,
+                          std::string &out) = 0;
+
+  /*
+    Create compression object for the given algorithm. Throws error if
+    the algorithm is not supported by this build.
+  */
+
+  static Compression* create(compression_type::value);
+};
+
+
+}}}  // cdk::protocol::mysqlx
+
+#endif
@@ -566,7 +566,9 @@ void set_find(Mysqlx::Crud::Find &msg,
 
 
 Protocol::Op&
-Protocol::snd_Find(Data_model dm,  uint32_t stmt_id, const Find_spec &fs, const api::Args_map *args)
+Protocol::snd_Find(Data_model dm,  uint32_t stmt_id, const Find_spec &fs,
+                   const api::Args_map *args,
+                   uint32_t cursor_id, row_count_t fetch_rows)
 {
   Msg_builder<msg_type::cli_CrudFind> find(get_impl(), stmt_id);
 
@@ -575,7 +577,7 @@ Protocol::snd_Find(Data_model dm,  uint32_t stmt_id, const Find_spec &fs, const
 
   set_find(find.msg(), dm, fs, find.conv());
 
-  return find.send();
+  return find.send(cursor_id, fetch_rows);
 }
 
 
@@ -830,13 +832,19 @@ Protocol::snd_Delete(Data_model dm,
 
 // -------------------------------------------------------------------------
 
-Protocol::Op&
-Protocol::snd_PrepareExecute(uint32_t stmt_id,
-                             const api::Limit *lim,
-                             const api::Args_map *args)
+/*
+  Fill m_prepare_execute message to execute prepared statement with the given
+  limit and parameter values.
+*/
+
+static
+void set_prepare_execute(Protocol_impl &proto,
+                         uint32_t stmt_id,
+                         const api::Limit *lim,
+                         const api::Args_map *args)
 {
-  auto& prepare_execute = get_impl().m_prepare_execute;
-  auto& conv = get_impl().m_args_conv;
+  auto& prepare_execute = proto.m_prepare_execute;
+  auto& conv = proto.m_args_conv;
 
   if (lim || args)
   {
@@ -857,8 +865,17 @@ Protocol::snd_PrepareExecute(uint32_t stmt_id,
   }
 
   prepare_execute.set_stmt_id(stmt_id);
+}
+
 
-  return get_impl().snd_start(prepare_execute, msg_type::cli_PrepareExecute);
+Protocol::Op&
+Protocol::snd_PrepareExecute(uint32_t stmt_id,
+                             const api::Limit *lim,
+                             const api::Args_map *args)
+{
+  set_prepare_execute(get_impl(), stmt_id, lim, args);
+  return get_impl().snd_start(get_impl().m_prepare_execute,
+                              msg_type::cli_PrepareExecute);
 }
 
 
@@ -874,6 +891,71 @@ Protocol::snd_PrepareDeallocate(uint32_t id)
 // -------------------------------------------------------------------------
 
 
+Protocol::Op&
+Protocol_impl::snd_CursorOpen(uint32_t cursor_id, row_count_t fetch_rows)
+{
+  Mysqlx::Cursor::Open open;
+
+  open.set_cursor_id(cursor_id);
+  if (0 < fetch_rows)
+    open.set_fetch_rows(fetch_rows);
+
+  /*
+    Note: The Execute message is owned by the protocol object, it is released
+    from the Open message after serializing it (which snd_start() does).
+  */
+
+  auto &stmt = *open.mutable_stmt();
+  stmt.set_type(Mysqlx::Cursor::Open_OneOfMessage_Type_PREPARE_EXECUTE);
+  stmt.set_allocated_prepare_execute(&m_prepare_execute);
+
+  try {
+    Protocol::Op &op = snd_start(open, msg_type::cli_CursorOpen);
+    stmt.release_prepare_execute();
+    return op;
+  }
+  catch (...)
+  {
+    stmt.release_prepare_execute();
+    throw;
+  }
+}
+
+
+Protocol::Op&
+Protocol::snd_CursorOpen(uint32_t cursor_id, uint32_t stmt_id,
+                         const api::Limit *lim,
+                         const api::Args_map *args,
+                         row_count_t fetch_rows)
+{
+  set_prepare_execute(get_impl(), stmt_id, lim, args);
+  return get_impl().snd_CursorOpen(cursor_id, fetch_rows);
+}
+
+
+Protocol::Op&
+Protocol::snd_CursorFetch(uint32_t cursor_id, row_count_t fetch_rows)
+{
+  Mysqlx::Cursor::Fetch fetch;
+  fetch.set_cursor_id(cursor_id);
+  if (0 < fetch_rows)
+    fetch.set_fetch_rows(fetch_rows);
+  return get_impl().snd_start(fetch, msg_type::cli_CursorFetch);
+}
+
+
+Protocol::Op&
+Protocol::snd_CursorClose(uint32_t cursor_id)
+{
+  Mysqlx::Cursor::Close close;
+  close.set_cursor_id(cursor_id);
+  return get_impl().snd_start(close, msg_type::cli_CursorClose);
+}
+
+
+// -------------------------------------------------------------------------
+
+
 template <class MSG>
 void set_view_columns(MSG &msg, const api::Columns &cols)
 {
@@ -150,7 +150,8 @@ Protocol_impl::Protocol_impl(Protocol::Stream *str, Protocol_side side)
 
   // Allocate initial I/O buffers
 
-  m_wr_size= m_rd_size= 512;
+  m_wr_size= 512;
+  m_rd_size= rd_buf_size;
   m_rd_buf= (byte*)malloc(m_rd_size);
   m_wr_buf= (byte*)malloc(m_wr_size);
 
@@ -193,12 +194,26 @@ private:
 void Protocol_impl::start_Pipeline()
 {
   m_pipeline = true;
+  ++m_pipeline_depth;
 }
 
 Protocol::Op& Protocol_impl::snd_Pipeline()
 {
   m_snd_op.reset();
-  m_snd_op.reset(new Op_snd_pipeline(*this));
+
+  /*
+    Inside a nested pipeline, or if there is nothing to write (because
+    messages were already written, see rd_start()), no data is sent here.
+  */
+
+  bool nested = 1 < m_pipeline_depth;
+
+  if (nested)
+    --m_pipeline_depth;
+  else if (0 == m_pipeline_size)
+    clear_Pipeline();
+
+  m_snd_op.reset(new Op_snd_pipeline(*this, m_pipeline && !nested));
   return *m_snd_op;
 }
 
@@ -206,6 +221,7 @@ void Protocol_impl::clear_Pipeline()
 {
   m_pipeline = false;
   m_pipeline_size = 0;
+  m_pipeline_depth = 0;
 }
 
 
@@ -280,6 +296,27 @@ Message* mk_message(Protocol_side side, msg_type_t msg_type)
 
 
 
+Message& Protocol_impl::rcv_message(msg_type_t msg_type)
+{
+  if (m_rcv_msgs.size() <= msg_type)
+    m_rcv_msgs.resize(msg_type + 1U);
+
+  std::unique_ptr<Message> &msg = m_rcv_msgs[msg_type];
+
+  if (!msg)
+    msg.reset(mk_message(m_side, msg_type));
+
+  return *msg;
+}
+
+
+void Protocol_impl::rcv_message_done(msg_type_t msg_type, size_t msg_size)
+{
+  if (msg_size > max_cached_msg_size)
+    m_rcv_msgs[msg_type].reset();
+}
+
+
 /*
   Protobuf error logger
   =====================
@@ -332,6 +369,27 @@ void Protocol_impl::write_msg(msg_type_t msg_type, Message &msg)
   if (m_wr_op)
     THROW("Can't write message while another one is written");
 
+  size_t frame_size = write_frame(msg_type, msg);
+
+  if (m_compression && frame_size >= m_compression_threshold)
+    frame_size = compress_frame(msg_type, frame_size);
+
+  m_pipeline_size += frame_size;
+
+  if (!m_pipeline)
+  {
+    write();
+  }
+}
+
+
+/*
+  Serialize message frame at the end of the output buffer and return its
+  size. The frame is not yet included in the data to be sent.
+*/
+
+size_t Protocol_impl::write_frame(msg_type_t msg_type, Message &msg)
+{
   msg_size_t net_size = static_cast<unsigned>(msg.ByteSize()) + 1;
 
   if (!resize_buf(CLIENT, header_length + net_size))
@@ -354,29 +412,71 @@ void Protocol_impl::write_msg(msg_type_t msg_type, Message &msg)
   if (!msg.SerializeToArray((void*)(wr_buffer() + header_length),
                             (int)(wr_size() - header_length)))
   {
-    m_pipeline = false;
-    m_pipeline_size = 0;
+    clear_Pipeline();
     throw_error(cdkerrc::protobuf_error, "Serialization error!");
   }
 
-  // Create write operation to send message payload
+  return net_size + header_length - 1;
+}
 
 
-  m_pipeline_size+=net_size+header_length - 1;
+/*
+  Replace the message frame just serialized by write_frame() with
+  a Compression frame containing it. Returns size of the new frame.
+*/
 
-  if (!m_pipeline)
+size_t Protocol_impl::compress_frame(msg_type_t msg_type, size_t frame_size)
+{
+  m_compr_msg.Clear();
+  m_compr_msg.set_uncompressed_size(frame_size);
+
+  // Note: m_side is the side from which we receive messages.
+
+  if (SERVER == m_side)
+    m_compr_msg.set_client_messages(msg_type);
+  else
+    m_compr_msg.set_server_messages(msg_type);
+
+  m_compression->compress(
+    bytes(wr_buffer(), frame_size), *m_compr_msg.mutable_payload()
+  );
+
+  return write_frame(
+    SERVER == m_side ? msg_type::cli_Compression : msg_type::Compression,
+    m_compr_msg
+  );
+}
+
+
+void Protocol_impl::set_compression(
+  compression_type::value algorithm, size_t threshold
+)
+{
+  if (compression_type::NONE == algorithm)
   {
-    write();
+    m_compression.reset();
+    return;
   }
+
+  m_compression.reset(Compression::create(algorithm));
+  m_compression_threshold = threshold;
 }
 
+
 void Protocol_impl::write()
 {
-  m_wr_op.reset(m_str->write(buffers(m_wr_buf, m_pipeline_size)));
+  write_pending();
   clear_Pipeline();
 }
 
 
+void Protocol_impl::write_pending()
+{
+  m_wr_op.reset(m_str->write(buffers(m_wr_buf, m_pipeline_size)));
+  m_pipeline_size = 0;
+}
+
+
 bool Protocol_impl::wr_cont()
 {
   if (!m_wr_op)
@@ -405,11 +505,17 @@ void Protocol_impl::read_header()
   if (HEADER == m_msg_state)
     return;
 
-  if (m_rd_op)
+  if (m_rd_pending)
     THROW("can't read header when reading payload is not completed");
 
-  m_rd_op.reset(m_str->read(buffers(m_rd_buf,4)));
+  // Consume payload of the previous message.
+
+  m_rd_pos += m_msg_size;
+  m_msg_size = 0;
+
   m_msg_state= HEADER;
+  m_rd_need= header_length;
+  m_rd_pending= true;
 }
 
 void Protocol_impl::read_payload()
@@ -420,32 +526,81 @@ void Protocol_impl::read_payload()
   if (HEADER != m_msg_state)
     THROW("payload can be read only after header");
 
-  if (m_rd_op)
+  if (m_rd_pending)
     THROW("can't read payload when reading header is not completed");
 
-  if (!resize_buf(SERVER, m_msg_size))
-      THROW("Not enough memory for input buffer");
-
-  if (m_msg_size > 0)
-    m_rd_op.reset(m_str->read(buffers(m_rd_buf, m_msg_size)));
   m_msg_state= PAYLOAD;
+  m_rd_need= m_msg_size;
+  m_rd_pending= true;
+}
+
+
+/*
+  Start read operation that appends bytes to the input buffer. Before that
+  the not yet consumed bytes are moved to the beginning of the buffer and
+  the buffer is enlarged if the bytes needed for the current stage would not
+  fit into it. The operation reads whatever is available in the stream, up to
+  the free space left in the buffer.
+*/
+
+void Protocol_impl::rd_start()
+{
+  assert(!m_rd_op);
+
+  /*
+    If messages are collected in a pipeline, they must be written before
+    waiting for server reply which otherwise would never come. The pipeline
+    stays active (with its nesting depth) until the outermost snd_Pipeline().
+  */
+
+  if (m_pipeline && 0 < m_pipeline_size)
+  {
+    write_pending();
+    wr_wait();
+  }
+
+  if (m_rd_pos > 0)
+  {
+    memmove(m_rd_buf, m_rd_buf + m_rd_pos, m_rd_end - m_rd_pos);
+    m_rd_end -= m_rd_pos;
+    m_rd_pos = 0;
+  }
+
+  if (!resize_buf(SERVER, m_rd_need))
+    THROW("Not enough memory for input buffer");
+
+  m_rd_op.reset(
+    m_str->read_some(buffers(m_rd_buf + m_rd_end, m_rd_buf + m_rd_size))
+  );
 }
 
 
 bool Protocol_impl::rd_cont()
 {
-  if (!m_rd_op)
+  if (!m_rd_pending)
     return true;
 
-  if (!m_rd_op->cont())
-    return false;
+  do {
 
-  m_rd_op.reset();
+    while (m_rd_end - m_rd_pos < m_rd_need)
+    {
+      if (!m_rd_op)
+        rd_start();
 
-  if (PAYLOAD == m_msg_state)
-    return true;
+      if (!m_rd_op->cont())
+        return false;
 
-  rd_process();
+      size_t howmuch = m_rd_op->get_result();
+      m_rd_op.reset();
+      m_rd_end += howmuch;
+
+      // Nothing was available in the stream - try again on next call.
+
+      if (0 == howmuch)
+        return false;
+    }
+
+  } while (!rd_done());
 
   return true;
 }
@@ -453,26 +608,123 @@ bool Protocol_impl::rd_cont()
 
 void Protocol_impl::rd_wait()
 {
-  if (m_rd_op)
-  {
-    m_rd_op->wait();
-    m_rd_op.reset();
+  if (!m_rd_pending)
+    return;
 
-    if (PAYLOAD == m_msg_state)
-      return;
+  do {
+
+    while (m_rd_end - m_rd_pos < m_rd_need)
+    {
+      if (!m_rd_op)
+        rd_start();
+
+      m_rd_op->wait();
+      m_rd_end += m_rd_op->get_result();
+      m_rd_op.reset();
+    }
+
+  } while (!rd_done());
+}
+
+
+/*
+  Called when bytes needed for the current stage are in the input buffer.
+  Returns false if more bytes must be read before the stage is completed,
+  which is the case when a Compression frame was seen.
+*/
+
+bool Protocol_impl::rd_done()
+{
+  m_rd_pending = false;
+
+  switch (m_msg_state)
+  {
+  case HEADER:
 
     rd_process();
+
+    if (m_compression &&
+        m_msg_type == (SERVER == m_side ?
+                       msg_type::Compression : msg_type::cli_Compression))
+    {
+      m_msg_state = COMPRESSED;
+      m_rd_need = m_msg_size;
+      m_rd_pending = true;
+      return false;
+    }
+    return true;
+
+  case COMPRESSED:
+
+    rd_uncompress();
+    m_msg_state = HEADER;
+    m_rd_need = header_length;
+    m_rd_pending = true;
+    return false;
+
+  default:
+    return true;
   }
 }
 
 
+/*
+  Decompress payload of the Compression frame which is now at the beginning
+  of the unconsumed part of the input buffer and replace the frame with
+  the decompressed frames, followed by whatever was read after it.
+*/
+
+void Protocol_impl::rd_uncompress()
+{
+  msg_type_t type = m_msg_type;
+  Mysqlx::Connection::Compression &msg
+    = static_cast<Mysqlx::Connection::Compression&>(rcv_message(type));
+
+  assert(m_msg_size < (size_t)std::numeric_limits<int>::max());
+  if (!msg.ParseFromArray(rd_payload(), (int)m_msg_size))
+    throw_error(cdkerrc::protobuf_error, "Message could not be parsed");
+
+  if (msg.uncompressed_size() > max_rd_size)
+    throw_error("Compressed frame is too big");
+
+  // Note: uncompress() rejects data whose size differs from the declared
+  // uncompressed size.
+
+  m_compression->uncompress(
+    bytes((byte*)msg.payload().data(), msg.payload().size()),
+    (size_t)msg.uncompressed_size(), max_rd_size, m_compr_buf
+  );
+
+  rcv_message_done(type, m_msg_size);
+
+  // Move the bytes that follow the Compression frame to the beginning of
+  // the buffer and then make room for the decompressed frames in front
+  // of them.
+
+  m_rd_pos += m_msg_size;
+  m_msg_size = 0;
+
+  size_t tail = m_rd_end - m_rd_pos;
+  memmove(m_rd_buf, m_rd_buf + m_rd_pos, tail);
+  m_rd_pos = 0;
+  m_rd_end = tail;
+
+  if (!resize_buf(SERVER, m_compr_buf.size() + tail))
+    THROW("Not enough memory for input buffer");
+
+  memmove(m_rd_buf + m_compr_buf.size(), m_rd_buf, tail);
+  memcpy(m_rd_buf, m_compr_buf.data(), m_compr_buf.size());
+  m_rd_end += m_compr_buf.size();
+}
+
+
 bool Protocol_impl::resize_buf(Protocol_side side, size_t requested_size)
 {
   byte*  &buf= (side == SERVER ? m_rd_buf : m_wr_buf);
   size_t &buf_size= (side == SERVER ? m_rd_size : m_wr_size);
 
   if (side == SERVER ?
-      requested_size < buf_size :
+      requested_size <= buf_size - m_rd_pos :
       requested_size < wr_size())
     return true;
 
@@ -491,7 +743,7 @@ bool Protocol_impl::resize_buf(Protocol_side side, size_t requested_size)
     if (side == CLIENT)
       new_size= m_pipeline_size+requested_size;
     else
-      new_size= requested_size;
+      new_size= m_rd_pos+requested_size;
     ptr= (byte*) realloc(buf, new_size);
   }
 
@@ -505,17 +757,23 @@ bool Protocol_impl::resize_buf(Protocol_side side, size_t requested_size)
 }
 
 
+/*
+  Extract message size and type from the header which is now at the
+  beginning of the unconsumed part of the input buffer.
+*/
+
 void Protocol_impl::rd_process()
 {
-  m_msg_size= *(msg_size_t*)m_rd_buf;
-  NTOHSIZE(m_msg_size);
-  assert(m_msg_size > 0);
-  m_msg_size--;
+  assert(m_rd_end - m_rd_pos >= header_length);
+
+  msg_size_t size;
+  memcpy(&size, m_rd_buf + m_rd_pos, sizeof(size));
+  NTOHSIZE(size);
+  assert(size > 0);
 
-  m_rd_op.reset(m_str->read(buffers(m_rd_buf, 1)));
-  m_rd_op->wait();
-  m_rd_op.reset();
-  m_msg_type= m_rd_buf[0];
+  m_msg_size= size - 1;
+  m_msg_type= m_rd_buf[m_rd_pos + header_length - 1];
+  m_rd_pos += header_length;
 }
 
 
@@ -713,15 +971,15 @@ void Op_rcv::process_payload()
 
   try {
 
-    byte *cur_pos = m_proto.m_rd_buf;
+    byte *cur_pos = m_proto.rd_payload();
     byte *end_pos = cur_pos + m_msg_size;
 
     /*
-      Note: read_header() checks if message fits into the buffer and
-      throws error if this is not the case.
+      Note: read_payload() makes sure that message fits into the buffer
+      and throws error if this is not the case.
     */
 
-    assert(m_msg_size <= m_proto.m_rd_size);
+    assert(m_proto.m_rd_pos + m_msg_size <= m_proto.m_rd_end);
 
     while (cur_pos < end_pos && m_read_window)
     {
@@ -744,24 +1002,42 @@ void Op_rcv::process_payload()
   if (m_skip)
     return;
 
-  // Parse message.
-
-  scoped_ptr<Message> m_msg;
-  m_msg.reset(mk_message(m_proto.m_side, m_msg_type));
+  /*
+    See if message can be processed without parsing it. Errors, such as
+    malformed message payload, are saved as if they were detected when
+    parsing the message.
+  */
 
-  if (m_msg_size > 0)
+  try {
+    if (process_raw(m_msg_type, bytes(m_proto.rd_payload(), m_msg_size)))
+      return;
+  }
+  catch (...)
   {
-    try {
+    save_error();
+    return;
+  }
+
+  // Parse message into object re-used for messages of this type.
+
+  Message *msg = NULL;
+
+  try {
+    msg = &m_proto.rcv_message(m_msg_type);
+
+    if (m_msg_size > 0)
+    {
       assert(m_msg_size < (size_t)std::numeric_limits<int>::max());
-      if (!m_msg->ParseFromArray(m_proto.m_rd_buf, (int)m_msg_size))
+      if (!msg->ParseFromArray(m_proto.rd_payload(), (int)m_msg_size))
         throw_error(cdkerrc::protobuf_error, "Message could not be parsed");
     }
-    catch (...)
-    {
-      save_error();
-      m_msg.reset();
-      return;
-    }
+    else
+      msg->Clear();
+  }
+  catch (...)
+  {
+    save_error();
+    return;
   }
 
 #ifdef DEBUG_PROTOBUF
@@ -773,14 +1049,23 @@ void Op_rcv::process_payload()
   cerr << "<<<< Received message <<<<" << endl;
   cerr << "of type " << m_msg_type <<": "
        << msg_type_name(SERVER, m_msg_type) << endl;
-  cerr << m_msg->DebugString();
+  cerr << msg->DebugString();
   cerr << "<<<<" << endl << endl;
 
 #endif
 
   // Pass data from parsed message to processor
 
-  process_msg(m_msg_type, *m_msg);
+  try {
+    process_msg(m_msg_type, *msg);
+  }
+  catch (...)
+  {
+    m_proto.rcv_message_done(m_msg_type, m_msg_size);
+    throw;
+  }
+
+  m_proto.rcv_message_done(m_msg_type, m_msg_size);
 }
 
 
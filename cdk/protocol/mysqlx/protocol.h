@@ -36,6 +36,11 @@
 #include <mysql/cdk/foundation/opaque_impl.i>
 #include <mysql/cdk/config.h>
 
+PUSH_SYS_WARNINGS_CDK
+#include <vector>
+#include <memory>
+POP_SYS_WARNINGS_CDK
+
 
 PUSH_PB_WARNINGS
 
@@ -57,6 +62,7 @@ PUSH_PB_WARNINGS
 POP_PB_WARNINGS
 
 #include "builders.h"
+#include "compression.h"
 
 namespace google {
 namespace protobuf {
@@ -111,6 +117,12 @@ const size_t header_length= 5;
 const size_t max_wr_size= 1024*1024*1024;  // 1GB
 const size_t max_rd_size= max_wr_size;
 
+/// Initial size of the input buffer into which incoming bytes are read ahead.
+const size_t rd_buf_size= 16*1024;
+
+/// Messages bigger than this are not kept for re-use after parsing.
+const size_t max_cached_msg_size= 64*1024;
+
 // TODO: use throw_error or any other appropriate method when the code is ready
 #define THROW_PROTOCOL_ERROR(ERR) throw ERR
 
@@ -161,6 +173,30 @@ public:
   Protocol::Op& snd_Pipeline();
   void clear_Pipeline();
 
+  /*
+    Tell whether the current read (write) operation can not proceed until
+    the connection becomes readable (writable).
+  */
+
+  bool wants_read() const
+  {
+    return m_rd_pending && (m_rd_op || m_rd_end - m_rd_pos < m_rd_need);
+  }
+
+  bool wants_write() const
+  {
+    return (bool)m_wr_op;
+  }
+
+  void set_compression(compression_type::value, size_t threshold);
+
+  /*
+    Send CursorOpen message which executes prepared statement described
+    by m_prepare_execute.
+  */
+
+  Protocol::Op& snd_CursorOpen(uint32_t cursor_id, row_count_t fetch_rows);
+
   /**
     Start async op that sends given message to the other end.
 
@@ -208,22 +244,43 @@ protected:
 
     Method read_payload() starts asynchronous reading of message payload.
     If payload has been already read, it does nothing. The payload is placed
-    in m_rd_buf buffer. This method can be called only after reading message
-    header.
+    in m_rd_buf buffer and rd_payload() points at its first byte. This method
+    can be called only after reading message header.
 
     To complete the asynchronous header/payload reading operation one has
     to call method rd_cont() until it returns true.
+
+    Bytes are read from the stream ahead of what is currently needed: each
+    read operation asks for as much as fits into the free space of m_rd_buf
+    and whatever the stream has available is kept there. Bytes between
+    m_rd_pos and m_rd_end are already read but not yet consumed. This way
+    a sequence of small messages is sliced from the buffer without issuing
+    separate stream reads for each header and payload.
+
+    If compression is enabled, a Compression frame is never reported to
+    the caller. When its header is read, its payload is read too (stage
+    COMPRESSED) and then the frame is replaced in the input buffer by the
+    decompressed frames, from which the next header is read.
   */
 
-  enum { HEADER, PAYLOAD }   m_msg_state;
+  enum { HEADER, PAYLOAD, COMPRESSED }   m_msg_state;
 
   void read_header();
   void read_payload();
   bool rd_cont();
   void rd_wait();
 
+  byte* rd_payload()
+  {
+    return m_rd_buf + m_rd_pos;
+  }
+
   byte   *m_rd_buf;
   size_t  m_rd_size;
+  size_t  m_rd_pos = 0;
+  size_t  m_rd_end = 0;
+  size_t  m_rd_need = 0;
+  bool    m_rd_pending = false;
   scoped_ptr<Protocol::Stream::Op> m_rd_op;
 
   // Info extracted from message header
@@ -239,7 +296,9 @@ protected:
     buffer, also calls write() if no pipeline is used.
 
     Method write() starts asynchronous operation which sends current write
-    buffer to the other end.
+    buffer to the other end and ends the pipeline, if any. Method
+    write_pending() does the same but the pipeline (if any) remains active
+    and further messages are collected in it.
 
     To complete writing operation one has to call method wr_cont() until it
     returns true.
@@ -247,6 +306,7 @@ protected:
 
 
   void write();
+  void write_pending();
   void write_msg(msg_type_t, Message&);
   bool wr_cont();
   void wr_wait();
@@ -263,10 +323,59 @@ protected:
   size_t  m_wr_size;
   bool m_pipeline = false;
   size_t  m_pipeline_size = 0;
+
+  /*
+    Number of start_Pipeline() calls not yet matched by snd_Pipeline().
+    Pipelines can be nested: only the outermost snd_Pipeline() writes
+    collected messages.
+  */
+
+  unsigned m_pipeline_depth = 0;
   scoped_ptr<Protocol::Stream::Op> m_wr_op;
 
   bool resize_buf(Protocol_side side, size_t new_size);
 
+  /*
+    Compression
+    -----------
+
+    When m_compression is set, outgoing messages with frames of at least
+    m_compression_threshold bytes are wrapped in Compression frames by
+    write_msg() and incoming Compression frames are decompressed by
+    rd_uncompress(). Buffer m_compr_buf keeps decompressed data and
+    m_compr_msg is used to build outgoing Compression messages so that their
+    memory is re-used between messages.
+  */
+
+  size_t write_frame(msg_type_t, Message&);
+  size_t compress_frame(msg_type_t, size_t frame_size);
+  void   rd_uncompress();
+
+  scoped_ptr<Compression> m_compression;
+  size_t m_compression_threshold = 0;
+  std::string m_compr_buf;
+  Mysqlx::Connection::Compression m_compr_msg;
+
+  /*
+    Message objects used for parsing incoming messages
+    --------------------------------------------------
+
+    Method rcv_message() returns protobuf message object of the given type
+    into which incoming message payload can be parsed. The object is created
+    on first use and then kept by the protocol instance so that subsequent
+    messages of the same type, such as rows of a result set, are parsed into
+    the same object re-using memory allocated by protobuf for its fields.
+
+    Method rcv_message_done() should be called after processing the message.
+    If the message was bigger than max_cached_msg_size, its object is deleted
+    so that memory used by it is not kept around.
+  */
+
+  Message& rcv_message(msg_type_t);
+  void     rcv_message_done(msg_type_t, size_t msg_size);
+
+  std::vector<std::unique_ptr<Message>> m_rcv_msgs;
+
 public:
 
   /**
@@ -285,6 +394,8 @@ public:
   };
 
 private:
+  void rd_start();
+  bool rd_done();
   void rd_process();
 
   // Pointers to the current send/receive operations
@@ -455,10 +566,11 @@ class Op_snd_pipeline : public Op_base
 {
 public:
 
-  Op_snd_pipeline(Protocol_impl &proto)
+  Op_snd_pipeline(Protocol_impl &proto, bool write = true)
     : Op_base(proto)
   {
-    m_proto.write();
+    if (write)
+      m_proto.write();
   }
 
   bool do_cont()
@@ -620,6 +732,19 @@ protected:
   virtual void process_msg(msg_type_t, Message&);
   virtual void do_process_msg(msg_type_t, Message&) {} // GCOV_EXCL_LINE
 
+  /*
+    Process raw message payload, before it is parsed. Specializations can
+    override it to decode messages of some types directly from the input
+    buffer, without creating protobuf message objects. If this method returns
+    true then the message is considered processed and process_msg() is not
+    called for it. Errors thrown by this method are saved and reported in
+    the same way as errors detected when parsing a message.
+
+    By default it returns false and all messages are parsed by protobuf.
+  */
+
+  virtual bool process_raw(msg_type_t, bytes) { return false; }
+
   /**
     This method is called after processing each message to determine
     if operation should continue processing next message or stop.
@@ -976,14 +1101,22 @@ public:
   void set_args(const api::Any_list *args);
 
 
-  Protocol::Op& send()
+  /*
+    If cursor_id is not 0, the prepared statement is executed by opening
+    a server-side cursor (see Protocol::snd_CursorOpen()).
+  */
+
+  Protocol::Op& send(uint32_t cursor_id = 0, row_count_t fetch_rows = 0)
   {
     if (m_stmt_id != 0)
     {
       m_protocol.start_Pipeline();
       m_protocol.snd_start(m_prepare, msg_type::cli_PreparePrepare).wait();
-      m_protocol.snd_start(m_prepare_execute, msg_type::cli_PrepareExecute)
-          .wait();
+      if (cursor_id)
+        m_protocol.snd_CursorOpen(cursor_id, fetch_rows).wait();
+      else
+        m_protocol.snd_start(m_prepare_execute, msg_type::cli_PrepareExecute)
+            .wait();
       return m_protocol.snd_Pipeline();
     }
     return m_protocol.snd_start(m_msg, T);
@@ -153,6 +153,18 @@ protected:
     throw_error("Invalid processor used to process server reply");
   }
 
+  /*
+    Row messages are decoded directly from the input buffer, without
+    protobuf parsing (see process_raw()). Member m_fields holds field
+    values of the current row which are then passed to the processor
+    by process_row(). Each value points into the input buffer (or into
+    a parsed message if protobuf was used).
+  */
+
+  bool process_raw(msg_type_t, bytes);
+  void process_row(Row_processor&);
+
+  std::vector<bytes> m_fields;
 };
 
 
@@ -210,7 +222,15 @@ void Rcv_result_base::resume(Stmt_processor &prc)
 
 void Rcv_result_base::resume(Row_processor &prc)
 {
-  if (ROWS != m_result_state || !m_completed)
+  /*
+    Reading rows at the start of server reply is possible for a reply to
+    CursorFetch command, which contains only rows of a result set whose
+    meta-data was sent earlier.
+  */
+
+  if (START == m_result_state)
+    m_result_state = ROWS;
+  else if (ROWS != m_result_state || !m_completed)
     throw_error("Rcv_result: incorrect resume: attempt to read rows"); //TODO: Improve error report
 
   // reset the row counter
@@ -281,6 +301,11 @@ bool Rcv_result_base::process_next()
            | FetchDoneMoreResultsets <rset>? <more>
   <rset> ::= MetaData+ Row*
 
+  Reply to CursorOpen command has the same form, except that the result set
+  can be ended by FetchSuspended if server did not send all its rows. Reply
+  to CursorFetch command has form Row* (FetchSuspended | FetchDone)
+  StmtExecuteOk, it is read starting in ROWS state.
+
   Below are few examples of valid message sequences in server reply and how
   they are distrbuted between different processing stages:
   A = reading meta-data, B = reading rows, C = reading final OK.
@@ -377,6 +402,14 @@ Op_rcv::Next_msg Rcv_result_base::do_next_msg(msg_type_t type)
         m_next_state = ROWS;
       break;
 
+    // Cursor was opened without sending any rows.
+
+    case msg_type::FetchSuspended:
+      if (0 == m_ccount)
+        return UNEXPECTED;
+      m_next_state = ROWS;
+      break;
+
     /*
       If we see StmtExecuteOk then the meta-data processing stage ends and we
       proceed to the final stage. The message will be part of the next stage.
@@ -436,7 +469,8 @@ Op_rcv::Next_msg Rcv_result_base::do_next_msg(msg_type_t type)
     {
     case msg_type::Row: return EXPECTED;
     case msg_type::FetchDone:
-      m_next_state = CLOSE;  // no more result-sets
+    case msg_type::FetchSuspended:
+      m_next_state = CLOSE;  // no more result-sets (in this reply)
       break;
     case msg_type::FetchDoneMoreResultsets:
       m_next_state = MDATA;  // proceed to next result-set
@@ -566,10 +600,37 @@ void Rcv_result_base::process_msg_with(
 
 
 
+template<>
+void Rcv_result_base::process_msg_with(
+  Mysqlx::Resultset::FetchSuspended&, Row_processor &rp
+)
+{
+  /*
+    Server sent all rows requested from a server-side cursor, more rows
+    can be fetched with CursorFetch command.
+  */
+  rp.fetch_suspended();
+}
+
+
 template<>
 void Rcv_result_base::process_msg_with(
   Mysqlx::Resultset::Row &row, Row_processor &rp
 )
+{
+  m_fields.clear();
+
+  for (RepeatedPtrField< ::std::string>::const_iterator it = row.field().begin();
+        it != row.field().end(); ++it)
+  {
+    m_fields.emplace_back((byte*)it->data(), it->length());
+  }
+
+  process_row(rp);
+}
+
+
+void Rcv_result_base::process_row(Row_processor &rp)
 {
   row_count_t rcount= m_rcount++;
 
@@ -578,34 +639,126 @@ void Rcv_result_base::process_msg_with(
 
   col_count_t ccount = 0;
 
-  for (RepeatedPtrField< ::std::string>::const_iterator it = row.field().begin();
-        it != row.field().end(); ++it, ++ccount)
+  for (std::vector<bytes>::const_iterator it = m_fields.begin();
+       it != m_fields.end(); ++it, ++ccount)
   {
 
-    if (it->length() == 0)
+    if (it->size() == 0)
     {
       rp.col_null(ccount);
       continue;
     }
 
-    size_t read_window = rp.col_begin(ccount, it->length());
+    size_t read_window = rp.col_begin(ccount, it->size());
     size_t pos= 0;
 
-    while (it->length() > pos && read_window)
+    while (it->size() > pos && read_window)
     {
-      size_t bytes_to_feed = it->length() - pos > read_window ? read_window : it->length() - pos;
-      size_t read_window_new = rp.col_data(ccount, bytes((byte*)(it->c_str() + pos), bytes_to_feed));
+      size_t bytes_to_feed = it->size() - pos > read_window ? read_window : it->size() - pos;
+      size_t read_window_new = rp.col_data(ccount, bytes(it->begin() + pos, bytes_to_feed));
       pos += read_window;
       read_window = read_window_new;
     }
 
-    rp.col_end(ccount, it->length());
+    rp.col_end(ccount, it->size());
   }
 
   rp.row_end(rcount);
 }
 
 
+/*
+  Decoding Row message
+  --------------------
+
+  Row message has single repeated bytes field. In protobuf wire format each
+  value of this field is encoded as the key (field number and wire type)
+  followed by value length and the value bytes. Keys and lengths are encoded
+  as varints. Fields with other numbers, if present, are skipped as protobuf
+  would do.
+
+  The values are not copied - m_fields holds byte ranges inside message
+  payload which sits in the protocol input buffer.
+*/
+
+static
+uint64_t read_varint(const byte *&pos, const byte *end)
+{
+  uint64_t val = 0;
+
+  for (unsigned shift = 0; shift < 64; shift += 7)
+  {
+    if (pos >= end)
+      break;
+
+    byte b = *pos++;
+    val |= static_cast<uint64_t>(b & 0x7F) << shift;
+
+    if (0 == (b & 0x80))
+      return val;
+  }
+
+  throw_error(cdkerrc::protobuf_error, "Message could not be parsed");
+  return 0;  // quiet compile warnings
+}
+
+
+bool Rcv_result_base::process_raw(msg_type_t type, bytes payload)
+{
+  if (ROWS != m_result_state || msg_type::Row != type)
+    return false;
+
+  // Wire types used by protobuf encoding.
+
+  enum { VARINT = 0, FIXED64 = 1, LENGTH_DELIMITED = 2, FIXED32 = 5 };
+
+  const byte *pos = payload.begin();
+  const byte *end = payload.end();
+
+  m_fields.clear();
+
+  while (pos < end)
+  {
+    uint64_t key = read_varint(pos, end);
+    uint64_t skip = 0;
+
+    switch (key & 0x7)
+    {
+    case VARINT:
+      read_varint(pos, end);
+      break;
+
+    case FIXED64:
+      skip = 8;
+      break;
+
+    case FIXED32:
+      skip = 4;
+      break;
+
+    case LENGTH_DELIMITED:
+      skip = read_varint(pos, end);
+      if (skip > static_cast<uint64_t>(end - pos))
+        break;
+      if (1 == (key >> 3))
+        m_fields.emplace_back(const_cast<byte*>(pos), static_cast<size_t>(skip));
+      break;
+
+    default:
+      throw_error(cdkerrc::protobuf_error, "Message could not be parsed");
+    }
+
+    if (skip > static_cast<uint64_t>(end - pos))
+      throw_error(cdkerrc::protobuf_error, "Message could not be parsed");
+
+    pos += skip;
+  }
+
+  process_row(*static_cast<Row_processor*>(m_prc));
+  return true;
+}
+
+
 /*
   Process column metadata
 */
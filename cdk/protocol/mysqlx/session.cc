@@ -101,6 +101,22 @@ void Protocol::clear_Pipeline()
   get_impl().clear_Pipeline();
 }
 
+bool Protocol::wants_read() const
+{
+  return get_impl().wants_read();
+}
+
+bool Protocol::wants_write() const
+{
+  return get_impl().wants_write();
+}
+
+void Protocol::set_compression(compression_type::value algorithm,
+                               size_t threshold)
+{
+  get_impl().set_compression(algorithm, threshold);
+}
+
 Protocol::Op& Protocol::snd_CapabilitiesSet(const api::Any::Document& caps)
 {
   Mysqlx::Connection::CapabilitiesSet msg;
@@ -0,0 +1,426 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2.0, as
+ * published by the Free Software Foundation.
+ *
+ * This program is also distributed with certain software (including
+ * but not limited to OpenSSL) that is licensed under separate terms,
+ * as designated in a particular file or component or in included license
+ * documentation.  The authors of MySQL hereby grant you an
+ * additional permission to link the program and your derivative works
+ * with the separately licensed software that they have included with
+ * MySQL.
+ *
+ * Without limiting anything contained in the foregoing, this file,
+ * which is part of MySQL Connector/C++, is also subject to the
+ * Universal FOSS Exception, version 1.0, a copy of which can be found at
+ * http://oss.oracle.com/licenses/universal-foss-exception.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License, version 2.0, for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin St, Fifth Floor, Boston, MA 02110-1301  USA
+ */
+
+#include <mysql/cdk.h>
+
+#include "expr_cache.h"
+
+#include <vector>
+
+/*
+  Implementation of parsed expressions and of the per-session cache of
+  parsed expressions.
+*/
+
+using namespace ::mysqlx::impl::common;
+
+
+/*
+  Node of a recorded expression tree.
+
+  Each node describes one "any" value: a scalar expression, an array or
+  a document. While recording, the node acts as all the processors that
+  can be used to describe such value. Sub-expressions (array elements,
+  operator or function arguments, document fields) are recorded in child
+  nodes.
+*/
+
+class Parsed_expr::Node
+  : public cdk::Expression::Processor
+  , public cdk::Expr_list::Processor
+  , public cdk::Expression::Processor::Doc_prc
+  , public cdk::Expr_processor
+  , public cdk::Value_processor
+{
+public:
+
+  using Any_prc = cdk::Expression::Processor;
+  using List_prc = cdk::Expr_list::Processor;
+  using Doc_prc = Any_prc::Doc_prc;
+
+  enum Kind {
+    NONE, ARR, DOC,
+    NUL, VALUE, STR, SINT, UINT, FLOAT, DOUBLE, BOOL,
+    OP, CALL, REF_COL, REF_PATH, PARAM_NAME, PARAM_POS, VAR
+  };
+
+  Kind m_kind = NONE;
+
+  /*
+    Name of the document field which is described by this node, if it is
+    a child of a DOC node.
+  */
+
+  cdk::string m_key;
+
+  // Storage for the recorded data (which members are used depends on kind).
+
+  cdk::string m_str;
+  std::string m_bytes;
+  cdk::Type_info m_type = cdk::TYPE_BYTES;
+
+  union {
+    int64_t   v_sint;
+    uint64_t  v_uint;
+    float     v_float;
+    double    v_double;
+    bool      v_bool;
+    uint16_t  v_pos;
+  } m_num;
+
+  parser::Column_ref     m_col;
+  parser::Table_ref      m_func;
+  cdk::Doc_path_storage  m_path;
+  bool m_has_path = false;
+
+  std::vector<std::unique_ptr<Node>> m_children;
+
+  Node* add_child()
+  {
+    m_children.emplace_back(new Node());
+    return m_children.back().get();
+  }
+
+  void process(Any_prc &prc) const;
+
+private:
+
+  void process_list(List_prc *prc) const;
+  void process_scalar(cdk::Expr_processor &prc) const;
+
+  // Any_processor
+
+  Scalar_prc* scalar() override
+  {
+    return this;
+  }
+
+  List_prc* arr() override
+  {
+    m_kind = ARR;
+    return this;
+  }
+
+  Doc_prc* doc() override
+  {
+    m_kind = DOC;
+    return this;
+  }
+
+  // List_processor
+
+  Any_prc* list_el() override
+  {
+    return add_child();
+  }
+
+  // Doc_processor
+
+  Any_prc* key_val(const cdk::string &key) override
+  {
+    Node *child = add_child();
+    child->m_key = key;
+    return child;
+  }
+
+  // Expr_processor
+
+  Value_prc* val() override
+  {
+    return this;
+  }
+
+  Args_prc* op(const char *name) override
+  {
+    m_kind = OP;
+    m_bytes = name;
+    return this;
+  }
+
+  Args_prc* call(const Object_ref &func) override
+  {
+    m_kind = CALL;
+    if (func.schema())
+      m_func.set(func.name(), func.schema()->name());
+    else
+      m_func.set(func.name());
+    return this;
+  }
+
+  void ref(const Column_ref &col, const Doc_path *path) override
+  {
+    m_kind = REF_COL;
+    m_col = col;
+    m_has_path = (nullptr != path);
+    if (path)
+      path->process(m_path);
+  }
+
+  void ref(const Doc_path &path) override
+  {
+    m_kind = REF_PATH;
+    path.process(m_path);
+  }
+
+  void param(const cdk::string &name) override
+  {
+    m_kind = PARAM_NAME;
+    m_str = name;
+  }
+
+  void param(uint16_t pos) override
+  {
+    m_kind = PARAM_POS;
+    m_num.v_pos = pos;
+  }
+
+  void var(const cdk::string &name) override
+  {
+    m_kind = VAR;
+    m_str = name;
+  }
+
+  // Value_processor
+
+  void null() override
+  {
+    m_kind = NUL;
+  }
+
+  void value(cdk::Type_info type, const cdk::Format_info&, cdk::bytes data)
+    override
+  {
+    m_kind = VALUE;
+    m_type = type;
+    m_bytes.assign(data.begin(), data.end());
+  }
+
+  void str(const cdk::string &val) override
+  {
+    m_kind = STR;
+    m_str = val;
+  }
+
+  void num(int64_t val) override
+  {
+    m_kind = SINT;
+    m_num.v_sint = val;
+  }
+
+  void num(uint64_t val) override
+  {
+    m_kind = UINT;
+    m_num.v_uint = val;
+  }
+
+  void num(float val) override
+  {
+    m_kind = FLOAT;
+    m_num.v_float = val;
+  }
+
+  void num(double val) override
+  {
+    m_kind = DOUBLE;
+    m_num.v_double = val;
+  }
+
+  void yesno(bool val) override
+  {
+    m_kind = BOOL;
+    m_num.v_bool = val;
+  }
+};
+
+
+void Parsed_expr::Node::process(Any_prc &prc) const
+{
+  switch (m_kind)
+  {
+  case NONE:
+    return;
+
+  case ARR:
+    process_list(prc.arr());
+    return;
+
+  case DOC:
+    {
+      Doc_prc *dprc = prc.doc();
+      if (!dprc)
+        return;
+      dprc->doc_begin();
+      for (const auto &child : m_children)
+      {
+        Any_prc *aprc = dprc->key_val(child->m_key);
+        if (aprc)
+          child->process(*aprc);
+      }
+      dprc->doc_end();
+    }
+    return;
+
+  default:
+    {
+      cdk::Expr_processor *sprc = prc.scalar();
+      if (sprc)
+        process_scalar(*sprc);
+    }
+    return;
+  }
+}
+
+
+void Parsed_expr::Node::process_scalar(cdk::Expr_processor &prc) const
+{
+  switch (m_kind)
+  {
+  case NUL:     safe_prc(prc)->val()->null(); return;
+  case STR:     safe_prc(prc)->val()->str(m_str); return;
+  case SINT:    safe_prc(prc)->val()->num(m_num.v_sint); return;
+  case UINT:    safe_prc(prc)->val()->num(m_num.v_uint); return;
+  case FLOAT:   safe_prc(prc)->val()->num(m_num.v_float); return;
+  case DOUBLE:  safe_prc(prc)->val()->num(m_num.v_double); return;
+  case BOOL:    safe_prc(prc)->val()->yesno(m_num.v_bool); return;
+
+  case VALUE:
+    safe_prc(prc)->val()->value(
+      m_type, parser::Format_info(), cdk::bytes(m_bytes)
+    );
+    return;
+
+  case OP:      process_list(prc.op(m_bytes.c_str())); return;
+  case CALL:    process_list(prc.call(m_func)); return;
+
+  case REF_COL: prc.ref(m_col, m_has_path ? &m_path : nullptr); return;
+  case REF_PATH:  prc.ref(m_path); return;
+
+  case PARAM_NAME:  prc.param(m_str); return;
+  case PARAM_POS:   prc.param(m_num.v_pos); return;
+  case VAR:         prc.var(m_str); return;
+
+  default:
+    assert(false);
+    return;
+  }
+}
+
+
+void Parsed_expr::Node::process_list(List_prc *prc) const
+{
+  if (!prc)
+    return;
+
+  prc->list_begin();
+  for (const auto &child : m_children)
+  {
+    Any_prc *aprc = prc->list_el();
+    if (aprc)
+      child->process(*aprc);
+  }
+  prc->list_end();
+}
+
+
+// -------------------------------------------------------------------------
+
+
+Parsed_expr::Parsed_expr(parser::Parser_mode::value mode,
+                         const std::string &expr)
+  : m_root(new Node())
+{
+  parser::Expression_parser parser(mode, expr);
+  parser.process(*m_root);
+}
+
+
+Parsed_expr::~Parsed_expr()
+{}
+
+
+void Parsed_expr::process(Processor &prc) const
+{
+  m_root->process(prc);
+}
+
+
+// -------------------------------------------------------------------------
+
+
+Expr_cache::Shared_expr
+Expr_cache::get(parser::Parser_mode::value mode, const std::string &expr)
+{
+  if (expr.length() > c_max_length)
+    return std::make_shared<Parsed_expr>(mode, expr);
+
+  Key key(mode, expr);
+
+  {
+    std::lock_guard<std::mutex> guard(m_mutex);
+
+    auto it = m_map.find(key);
+    if (it != m_map.end())
+    {
+      m_entries.splice(m_entries.begin(), m_entries, it->second);
+      return it->second->second;
+    }
+  }
+
+  /*
+    Note: Parsing is done outside of the lock. If expression can not be
+    parsed, the error is thrown here and nothing is stored in the cache.
+  */
+
+  Shared_expr parsed = std::make_shared<Parsed_expr>(mode, expr);
+
+  std::lock_guard<std::mutex> guard(m_mutex);
+
+  if (m_map.count(key))
+    return parsed;
+
+  m_entries.emplace_front(key, parsed);
+  m_map[key] = m_entries.begin();
+
+  if (m_entries.size() > c_capacity)
+  {
+    m_map.erase(m_entries.back().first);
+    m_entries.pop_back();
+  }
+
+  return parsed;
+}
+
+
+void Expr_cache::clear()
+{
+  std::lock_guard<std::mutex> guard(m_mutex);
+  m_map.clear();
+  m_entries.clear();
+}
@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2.0, as
+ * published by the Free Software Foundation.
+ *
+ * This program is also distributed with certain software (including
+ * but not limited to OpenSSL) that is licensed under separate terms,
+ * as designated in a particular file or component or in included license
+ * documentation.  The authors of MySQL hereby grant you an
+ * additional permission to link the program and your derivative works
+ * with the separately licensed software that they have included with
+ * MySQL.
+ *
+ * Without limiting anything contained in the foregoing, this file,
+ * which is part of MySQL Connector/C++, is also subject to the
+ * Universal FOSS Exception, version 1.0, a copy of which can be found at
+ * http://oss.oracle.com/licenses/universal-foss-exception.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License, version 2.0, for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin St, Fifth Floor, Boston, MA 02110-1301  USA
+ */
+
+#ifndef MYSQLX_COMMON_EXPR_CACHE_H
+#define MYSQLX_COMMON_EXPR_CACHE_H
+
+#include <mysql/cdk.h>
+#include <expr_parser.h>
+
+#include <string>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+
+
+namespace mysqlx {
+namespace impl {
+namespace common {
+
+
+/*
+  Expression which was parsed once and can be described to expression
+  processors many times without invoking the parser again.
+
+  When constructed, the expression string is parsed and parser callbacks are
+  recorded in a tree of nodes. Method process() replays the recorded
+  callbacks. Parse errors are reported by the constructor.
+
+  Note: Opaque values reported by the parser (such as operator names passed
+  as TYPE_BYTES) are replayed with the trivial parser::Format_info, which is
+  what the parser itself uses for them.
+*/
+
+class Parsed_expr
+  : public cdk::Expression
+{
+public:
+
+  Parsed_expr(parser::Parser_mode::value mode, const std::string &expr);
+  ~Parsed_expr();
+
+  void process(Processor &prc) const override;
+
+  class Node;
+
+private:
+
+  std::unique_ptr<Node> m_root;
+};
+
+
+/*
+  Cache of parsed expressions used by CRUD operations of a single session.
+
+  Given parser mode and expression string, method get() returns a shared
+  pointer to the parsed expression. If the same expression was parsed before,
+  the cached instance is returned. The cache keeps up to `c_capacity` most
+  recently used expressions. Long expression strings are parsed but not
+  cached.
+*/
+
+class Expr_cache
+{
+public:
+
+  using Shared_expr = std::shared_ptr<const Parsed_expr>;
+
+  static const size_t c_capacity = 128;
+  static const size_t c_max_length = 4096;
+
+  Shared_expr get(parser::Parser_mode::value mode, const std::string &expr);
+
+  void clear();
+
+private:
+
+  using Key = std::pair<int, std::string>;
+  using Entry = std::pair<Key, Shared_expr>;
+  using Entry_list = std::list<Entry>;
+
+  // Entries in the order of use, the most recently used one first.
+
+  Entry_list m_entries;
+  std::map<Key, Entry_list::iterator> m_map;
+  std::mutex m_mutex;
+};
+
+
+}}}  // mysqlx::impl::common
+
+#endif
@@ -90,6 +90,8 @@ enum class Object_type
 template <class IF>
 class Op_base
   : public IF
+  , public common::Executable_async_if
+  , public common::Executable_fetch_if
   , protected Result_init
 {
 public:
@@ -120,6 +122,10 @@ protected:
   bool m_inited = false;
   bool m_completed = false;
 
+  // Fetch size for results of this operation, 0 if session's one is used.
+
+  row_count_t m_fetch_size = 0;
+
 public:
 
   Op_base(const Shared_session_impl &sess)
@@ -137,10 +143,27 @@ public:
     : m_sess(other.m_sess)
     , m_stmt_id(other.m_stmt_id)
     , m_prepare_state(other.m_prepare_state)
+    , m_fetch_size(other.m_fetch_size)
   {}
 
   virtual ~Op_base() override
   {
+    /*
+      A command started by send() can refer to data of this operation until
+      it is completely written. If the operation is abandoned before that,
+      writing is finished here, so that the reply can outlive the operation
+      (see Session_impl::op_abandoned()).
+    */
+
+    try {
+      while (m_reply && !m_completed && !m_reply->stmt_sent())
+        m_reply->cont();
+    }
+    catch (...)
+    {}
+
+    if (m_sess && m_sess->op_abandoned(this, m_reply.get()))
+      m_reply.release();
     release_stmt_id();
   }
 
@@ -171,6 +194,18 @@ public:
     m_stmt_id.reset();
   }
 
+  /*
+    Return parsed form of the given expression. Expressions are parsed once
+    per session and then re-used from the session's expression cache.
+  */
+
+  Expr_cache::Shared_expr
+  get_expr(parser::Parser_mode::value mode, const string &expr) const
+  {
+    assert(m_sess);
+    return m_sess->m_expr_cache.get(mode, expr);
+  }
+
 
   /*
     Clears operation state and, if stmt_id != 0, informe session about error on
@@ -179,6 +214,8 @@ public:
 
   void reset_state()
   {
+    if (m_stmt_id)
+      get_session()->uncache_stmt(m_stmt_id);
     if (m_stmt_id.unique())
       get_session()->error_stmt_id(*m_stmt_id);
     m_stmt_id.reset();
@@ -233,6 +270,18 @@ public:
 
     m_sess->prepare_for_cmd();
     m_reply.reset(send_command());
+
+    /*
+      If requested, rows of the result are streamed from a server-side
+      cursor. The first batch is of the same size as the first batch loaded
+      by the result object. Note that the cursor can be used only if the
+      statement is executed as a prepared statement.
+    */
+
+    if (m_reply && server_cursor())
+      m_reply->use_cursor(
+        Result_impl::initial_prefetch_size(get_fetch_size())
+      );
   }
 
   bool is_completed()
@@ -315,13 +364,81 @@ public:
     // Can not execute operation that is already completed.
     assert(!m_completed);
 
-    execute_prepare();
+    /*
+      If the command was already sent by send(), results of operations
+      sent before it must be consumed (cached) first. Note that this works
+      only for operations whose results were already retrieved, which is
+      checked by check_sent_op().
+    */
+
+    m_sess->prepare_for_cmd();
+
+    if (m_inited)
+    {
+      m_sess->check_sent_op(this);
+      m_sess->op_done(this);
+    }
+    else
+    {
+      m_sess->check_sent_op(nullptr);
+      execute_prepare();
+    }
+
     wait();
     execute_cleanup();
 
     return *this;
   }
 
+  void send() override
+  {
+    assert(!m_completed);
+
+    if (m_inited)
+      return;
+
+    execute_prepare();
+    init();
+    m_sess->op_sent(this);
+
+    // Note: Writing of the command is completed by poll() or execute().
+  }
+
+  /*
+    Note: If server reports an error, poll() returns true and the error is
+    thrown by the following execute() call.
+  */
+
+  bool poll() override
+  {
+    assert(!m_completed);
+
+    send();
+
+    if (m_reply && !m_reply->is_completed())
+    try {
+      // Note: cont() re-executes the statement if it could not be prepared.
+      cont();
+    }
+    catch (...)
+    {
+      if (!m_reply || 0 == m_reply->entry_count())
+        throw;
+    }
+
+    return !m_reply || m_reply->is_completed();
+  }
+
+  void set_fetch_size(uint64_t rows) override
+  {
+    m_fetch_size = rows;
+  }
+
+  row_count_t get_fetch_size() const
+  {
+    return 0 < m_fetch_size ? m_fetch_size : m_sess->m_fetch_size;
+  }
+
 protected:
 
   /*
@@ -345,6 +462,52 @@ protected:
     return nullptr;
   }
 
+  /*
+    Return a key which describes the shape of the statement: its kind, target
+    and all clauses that are fixed when the statement is prepared. Statements
+    with the same key can execute the same server-side prepared statement,
+    which is found in the session-wide statement cache. Empty key means that
+    the statement should not be shared with other statement objects.
+
+    Derived classes build the key using add_key_parts(), to which each
+    template in the chain adds the clauses it handles.
+  */
+
+  virtual string get_stmt_key()
+  {
+    return string();
+  }
+
+  /*
+    Return true if result rows should be streamed from a server-side cursor.
+    Such statements are executed as prepared statements from the first
+    execution on.
+  */
+
+  virtual bool server_cursor()
+  {
+    return false;
+  }
+
+  void add_key_parts(string&) const
+  {}
+
+  static void add_key_part(string &key, char tag, const string &val)
+  {
+    key.push_back(tag);
+    key.append(val);
+    key.push_back('\0');
+  }
+
+  static string stmt_key(const char *kind, const cdk::api::Object_ref &obj)
+  {
+    string key(kind);
+    if (obj.schema())
+      add_key_part(key, 'S', obj.schema()->name());
+    add_key_part(key, 'O', obj.name());
+    return key;
+  }
+
   /*
     Either call do_send_command() to send (and possibly prepare) a command or,
     if there is an up-to-date prepared statement for the original command, send
@@ -381,8 +544,7 @@ protected:
 
   /*
     Hooks that are called just before and after execution of the operation.
-
-    TODO: Currently these hooks are not called when executing asynchronously.
+    If operation is started with send(), execute_prepare() is called there.
   */
 
   // LCOV_EXCL_START
@@ -447,6 +609,16 @@ protected:
     return m_sess;
   }
 
+  /*
+    Derived classes that override init_result() should call this
+    implementation too.
+  */
+
+  void init_result(Result_impl &res) override
+  {
+    res.m_fetch_size = get_fetch_size();
+  }
+
   cdk::Reply* get_reply() override
   {
     if (!is_completed())
@@ -497,13 +669,45 @@ private:
       used.
     */
 
-    if (prepare == PS_PREPARE_EXECUTE )
+    if (prepare == PS_EXECUTE)
     {
-      create_stmt_id();
+      release_stmt_id();
     }
-    else if (prepare == PS_EXECUTE)
+
+    /*
+      Statements with the same shape share prepared statements via the
+      session-wide cache. If a statement with the same key was prepared
+      before (possibly by other statement object), its prepared statement is
+      used. If it was executed before but not prepared, it is prepared now.
+    */
+
+    string key;
+
+    if (prepare != PS_EXECUTE_PREPARED)
     {
-      release_stmt_id();
+      key = get_stmt_key();
+
+      Shared_stmt_id id;
+      if (!key.empty() && m_sess->find_stmt(key, id))
+      {
+        if (id)
+        {
+          release_stmt_id();
+          m_stmt_id = id;
+          set_prepare_state(PS_EXECUTE_PREPARED);
+          return true;
+        }
+        prepare = PS_PREPARE_EXECUTE;
+      }
+    }
+
+    if (prepare == PS_EXECUTE && server_cursor())
+      prepare = PS_PREPARE_EXECUTE;
+
+    if (prepare == PS_PREPARE_EXECUTE)
+    {
+      create_stmt_id();
+      cache_stmt_id(key);
     }
 
     switch(prepare)
@@ -521,6 +725,12 @@ private:
     return prepare == PS_EXECUTE_PREPARED &&
         get_stmt_id()!=0;
   }
+
+  void cache_stmt_id(const string &key)
+  {
+    if (!key.empty() && 0 != get_stmt_id())
+      m_sess->cache_stmt(key, m_stmt_id);
+  }
 };
 
 
@@ -617,6 +827,18 @@ public:
     return m_map.empty() ? nullptr : this;
   }
 
+  /*
+    Note: Parameter values are passed to prepared statement by position, so
+    statements bound to different sets of parameters can not share it.
+  */
+
+  void add_key_parts(string &key) const
+  {
+    Base::add_key_parts(key);
+    for (const auto &el : m_map)
+      Base::add_key_part(key, 'P', el.first);
+  }
+
   cdk::Reply* send_command() override
   {
     return Base::send_prepared_command(nullptr, get_params());
@@ -730,6 +952,14 @@ protected:
     return m_has_limit || m_has_offset ? this : nullptr;
   }
 
+  // Note: Limit values are not part of the prepared statement.
+
+  void add_key_parts(std::string &key) const
+  {
+    Base::add_key_parts(key);
+    Base::add_key_part(key, 'L', m_has_limit || m_has_offset ? "1" : "0");
+  }
+
 
   cdk::Reply* send_command() override
   {
@@ -821,6 +1051,13 @@ public:
     return m_order.empty() ? nullptr : this;
   }
 
+  void add_key_parts(string &key) const
+  {
+    Base::add_key_parts(key);
+    for (const order_item &item : m_order)
+      Base::add_key_part(key, char('0' + item.m_dir), item.m_expr);
+  }
+
 private:
 
   // cdk::Order_by interface
@@ -840,10 +1077,11 @@ private:
       case order_item::ASC:
       case order_item::DESC:
         {
-          parser::Expression_parser parser(PM, item.m_expr);
-          parser.process_if(el->sort_key(
+          auto *kprc = el->sort_key(
             cdk::api::Sort_direction::value(item.m_dir)
-          ));
+          );
+          if (kprc)
+            Base::get_expr(PM, item.m_expr)->process(*kprc);
         }
         break;
 
@@ -908,14 +1146,19 @@ public:
     return m_having.empty() ? nullptr : this;
   }
 
+  void add_key_parts(string &key) const
+  {
+    Base::add_key_parts(key);
+    Base::add_key_part(key, 'H', m_having);
+  }
+
 private:
 
   // cdk::Expression processor
 
   void process(cdk::Expression::Processor& prc) const override
   {
-    parser::Expression_parser expr_parser(PM, m_having);
-    expr_parser.process(prc);
+    Base::get_expr(PM, m_having)->process(prc);
   }
 };
 
@@ -964,6 +1207,13 @@ public:
     return m_group_by.empty() ? nullptr : this;
   }
 
+  void add_key_parts(string &key) const
+  {
+    Base::add_key_parts(key);
+    for (const string &el : m_group_by)
+      Base::add_key_part(key, 'G', el);
+  }
+
 private:
 
   // Expr_list
@@ -972,10 +1222,11 @@ private:
   {
     prc.list_begin();
 
-    for (string el : m_group_by)
+    for (const string &el : m_group_by)
     {
-      parser::Expression_parser expr_parser(PM, el);
-      expr_parser.process_if(prc.list_el());
+      auto *eprc = prc.list_el();
+      if (eprc)
+        Base::get_expr(PM, el)->process(*eprc);
     }
 
     prc.list_end();
@@ -1044,6 +1295,14 @@ public:
     return m_projections.empty() && m_doc_proj.empty() ? nullptr : this;
   }
 
+  void add_key_parts(string &key) const
+  {
+    Base::add_key_parts(key);
+    Base::add_key_part(key, 'D', m_doc_proj);
+    for (const string &el : m_projections)
+      Base::add_key_part(key, 'F', el);
+  }
+
 private:
 
   // cdk::Expression::Document
@@ -1086,11 +1345,8 @@ private:
 
       eprc.m_prc = &prc;
 
-      parser::Expression_parser parser(
-        parser::Parser_mode::DOCUMENT, m_doc_proj
-      );
-
-      parser.process(eprc);
+      Base::get_expr(parser::Parser_mode::DOCUMENT, m_doc_proj)
+        ->process(eprc);
 
       return;
     }
@@ -1155,19 +1411,19 @@ protected:
 
   string m_where_expr;
   bool   m_where_set = false;
-  std::unique_ptr<parser::Expression_parser> m_expr;
+  Expr_cache::Shared_expr     m_where;
   cdk::Lock_mode_value        m_lock_mode = cdk::api::Lock_mode::NONE;
   cdk::Lock_contention_value
     m_lock_contention = cdk::api::Lock_contention::DEFAULT;
 
 
-  // Note: we do not copy m_expr to avoid invoking copy ctor
-  // for Expression_parser
+  // Note: parsed expressions are immutable and can be shared between copies.
 
   Op_select(const Op_select &other)
     : Base(other)
     , m_where_expr(other.m_where_expr)
     , m_where_set(other.m_where_set)
+    , m_where(other.m_where)
     , m_lock_mode(other.m_lock_mode)
     , m_lock_contention(other.m_lock_contention)
   {}
@@ -1181,6 +1437,7 @@ public:
   {
     m_where_expr = expr;
     m_where_set = true;
+    m_where.reset();
     Base::set_prepare_state(Base::PS_EXECUTE);
   }
 
@@ -1200,6 +1457,16 @@ public:
     Base::set_prepare_state(Base::PS_EXECUTE);
   }
 
+  void add_key_parts(string &key) const
+  {
+    Base::add_key_parts(key);
+    Base::add_key_part(key, m_where_set ? 'W' : 'w', m_where_expr);
+    Base::add_key_part(key, 'K',
+      std::to_string(int(m_lock_mode)) + "," +
+      std::to_string(int(m_lock_contention))
+    );
+  }
+
   cdk::Expression* get_where() const
   {
     if (m_where_expr.empty())
@@ -1209,10 +1476,13 @@ public:
       return nullptr;
     }
 
-    auto *self = const_cast<Op_select*>(this);
+    if (!m_where)
+    {
+      auto *self = const_cast<Op_select*>(this);
+      self->m_where = Base::get_expr(PM, m_where_expr);
+    }
 
-    self->m_expr.reset(new parser::Expression_parser(PM, m_where_expr));
-    return m_expr.get();
+    return const_cast<Parsed_expr*>(m_where.get());
   }
 };
 
@@ -1769,7 +2039,7 @@ struct Op_list_objects
   template <Object_type T>
   static bool check_type(const Row_data &row)
   {
-    cdk::bytes  name_col = row.at(1).data();
+    cdk::bytes  name_col = row.at(1);
     std::string name(name_col.begin(), name_col.end()-1);
     return name == obj_name<T>();
   }
@@ -1792,6 +2062,7 @@ struct Op_list
 
   void init_result(Result_impl &res) override
   {
+    Op_list_objects::init_result(res);
     res.m_row_filter = check_type<T>;
   }
 };
@@ -1817,6 +2088,8 @@ struct Op_list<Object_type::TABLE>
 
   void init_result(Result_impl &res) override
   {
+    Op_list_objects::init_result(res);
+
     /*
       Note: not binding to m_include_views inside lambdas to not make
       the result object dependent on this operation object.
@@ -1903,26 +2176,95 @@ bool check_object_exists(
   (in init_result() method).
 
   Implementation object stores list of JSON strings describing documents
-  to be added and passed with `add_json` method. It presents this list
-  of documents via cdk::Doc_source interface. See method `process` for
-  details.
+  to be added and passed with `add_json` method. Further documents can be
+  read from a source set with `set_json_source` when the operation is
+  executed.
+
+  If only documents given by `add_json` are present, they are all sent in
+  a single collection add command, as usual. But if a source is set,
+  documents are sent to the server in chunks: each chunk is sent in
+  a separate collection add command with at most `max_chunk_size` bytes of
+  JSON data (a single bigger document forms a chunk on its own). Commands
+  for consecutive chunks are pipelined, but at most `max_chunks_in_flight`
+  of them wait for server reply at any time -- before sending next chunk
+  the oldest one is completed and its documents are released. This way
+  large collections of documents can be added without keeping all of them
+  in memory and without a round-trip for each chunk. Affected rows counts,
+  generated ids and diagnostic entries reported for all chunks are combined
+  in the final result.
+
+  Note: If adding a chunk fails, the error is reported and no more chunks
+  are sent. However, documents from chunks sent before the failed one are
+  added and, because of pipelining, also up to `max_chunks_in_flight - 1`
+  chunks sent after it might have been already added by the server (unless
+  the whole operation is executed inside a transaction that is rolled back).
 
   Overriden method Op_base::send_command() sends the collection add
-  command to the CDK session.
+  command(s) to the CDK session.
 */
 
 class Op_collection_add
   : public Op_base<common::Collection_add_if>
+  , public common::Collection_add_source_if
   , public cdk::Doc_source
 {
   using string = std::string;
 
+  static const size_t max_chunk_size = 16*1024*1024;
+  static const size_t max_chunks_in_flight = 4;
+
+  /*
+    Documents sent in a single command. Chunk presents them via
+    cdk::Doc_source interface and owns reply to the command.
+  */
+
+  struct Chunk
+    : public cdk::Doc_source
+  {
+    std::vector<std::string> m_json;  // note: UTF8 JSON strings
+    size_t m_size = 0;
+    size_t m_pos = 0;
+    cdk::scoped_ptr<cdk::Reply> m_reply;
+
+    bool next() override
+    {
+      if (m_pos >= m_json.size())
+        return false;
+      ++m_pos;
+      return true;
+    }
+
+    void process(cdk::Expression::Processor &ep) const override
+    {
+      // TODO: Report as opaque value of type DOCUMENT using JSON format.
+      ep.scalar()->val()->str(m_json.at(m_pos-1));
+    }
+  };
+
   Object_ref    m_coll;
   std::vector<std::string> m_json;  // note: UTF8 JSON strings
+  Json_source   m_source;
   unsigned m_pos;
   const cdk::Expression *m_expr = nullptr;
   bool m_upsert = false;
 
+  /*
+    Chunks sent during execution. All except the last one have their own
+    reply objects. Reply for the last chunk is the reply of the operation.
+    Chunks are removed from the list (and their replies completed) in
+    complete_chunk() which accumulates affected rows count, generated
+    ids and diagnostic entries in the members below.
+  */
+
+  std::list<Chunk> m_chunks;
+  size_t m_next_json = 0;
+  std::string m_pending;
+  bool m_has_pending = false;
+  cdk::row_count_t m_affected_rows = 0;
+  std::vector<std::string> m_generated_ids;
+  cdk::Diagnostic_arena m_entries;
+  bool m_multi_chunk = false;
+
 public:
 
   Op_collection_add(
@@ -1936,6 +2278,18 @@ public:
     , m_upsert(upsert)
   {}
 
+  // Note: Execution state (chunks being sent) is not copied.
+
+  Op_collection_add(const Op_collection_add &other)
+    : Op_base(other)
+    , m_coll(other.m_coll)
+    , m_json(other.m_json)
+    , m_source(other.m_source)
+    , m_pos(0)
+    , m_expr(other.m_expr)
+    , m_upsert(other.m_upsert)
+  {}
+
   Executable_if* clone() const override
   {
     return new Op_collection_add(*this);
@@ -1962,9 +2316,18 @@ public:
     m_json.push_back(json);
   }
 
+  void set_json_source(const Json_source &source) override
+  {
+    m_source = source;
+  }
+
   void clear_docs() override
   {
     m_json.clear();
+    m_source = nullptr;
+    m_chunks.clear();
+    m_pending.clear();
+    m_has_pending = false;
   }
 
 
@@ -1975,6 +2338,8 @@ public:
 
   void execute_cleanup() override
   {
+    complete_chunks();
+
     // Doc source has been consumed - no need to keep the data
     clear_docs();
   }
@@ -1982,17 +2347,92 @@ public:
 
   cdk::Reply* send_command() override
   {
+    // Issue coll_add statement where the document is described by
+    // expression given by add_doc().
+
+    if (m_expr)
+    {
+      return new cdk::Reply(
+        get_cdk_session().coll_add(m_coll, *this, nullptr, m_upsert)
+      );
+    }
+
+    m_chunks.clear();
+    m_next_json = 0;
+    m_has_pending = false;
+    m_affected_rows = 0;
+    m_generated_ids.clear();
+    m_entries.clear();
+    m_multi_chunk = false;
+
+    // Send commands for consecutive chunks until all documents are sent.
+
+    for (;;)
+    {
+      m_chunks.emplace_back();
+      Chunk &chunk = m_chunks.back();
+
+      if (!fill_chunk(chunk))
+      {
+        m_chunks.pop_back();
+        break;
+      }
+
+      if (1 < m_chunks.size())
+        m_multi_chunk = true;
+
+      if (max_chunks_in_flight < m_chunks.size())
+        complete_chunk();
+
+      chunk.m_reply.reset(new cdk::Reply(
+        get_cdk_session().coll_add(m_coll, chunk, nullptr, m_upsert)
+      ));
+    }
+
     // Do nothing if no documents were specified.
 
-    if (!m_expr && m_json.empty())
+    if (m_chunks.empty())
       return nullptr;
 
-    // Issue coll_add statement where documents are described by list
-    // of expressions defined by this instance.
+    // Reply for the last chunk becomes the reply of this operation.
 
-    return new cdk::Reply(
-      get_cdk_session().coll_add(m_coll, *this, nullptr, m_upsert)
-    );
+    return m_chunks.back().m_reply.release();
+  }
+
+
+  /*
+    Before the reply is passed to the result, complete all remaining
+    chunks, reporting errors, if any.
+  */
+
+  cdk::Reply* get_reply() override
+  {
+    if (is_completed())
+      complete_chunks();
+
+    return Op_base::get_reply();
+  }
+
+  void init_result(Result_impl &res) override
+  {
+    Op_base::init_result(res);
+
+    if (!m_multi_chunk)
+      return;
+
+    /*
+      Affected rows, ids generated and diagnostic entries (warnings) for
+      earlier chunks are combined with those for the last chunk, reported
+      by the reply of the result.
+    */
+
+    res.m_more_affected_rows = m_affected_rows;
+    const auto &ids = res.get_generated_ids();
+    m_generated_ids.insert(m_generated_ids.end(), ids.begin(), ids.end());
+    res.m_generated_ids = std::move(m_generated_ids);
+    m_generated_ids.clear();
+    res.add_entries(m_entries);
+    m_entries.clear();
   }
 
 
@@ -2000,12 +2440,7 @@ public:
 
   bool next() override
   {
-    if (m_expr)
-    {
-      if (m_pos > 0)
-        return false;
-    }
-    else if (m_pos >= m_json.size())
+    if (!m_expr || m_pos > 0)
       return false;
     ++m_pos;
     return true;
@@ -2013,6 +2448,92 @@ public:
 
   void process(cdk::Expression::Processor &ep) const override;
 
+private:
+
+  /*
+    Move next documents to the given chunk, first the ones given by
+    add_json(), then the ones read from the source. Returns false if there
+    are no more documents. The chunk size is limited only if the source
+    is set -- otherwise all documents are moved to a single chunk.
+  */
+
+  bool fill_chunk(Chunk &chunk)
+  {
+    for (;;)
+    {
+      if (!m_has_pending && !next_json(m_pending))
+        break;
+
+      m_has_pending = true;
+
+      // If the chunk is full, the pending document starts the next chunk.
+
+      if (m_source && !chunk.m_json.empty()
+          && chunk.m_size + m_pending.size() > max_chunk_size)
+        break;
+
+      chunk.m_size += m_pending.size();
+      chunk.m_json.push_back(std::move(m_pending));
+      m_pending.clear();
+      m_has_pending = false;
+    }
+
+    return !chunk.m_json.empty();
+  }
+
+  bool next_json(std::string &json)
+  {
+    if (m_next_json < m_json.size())
+    {
+      json = std::move(m_json[m_next_json++]);
+      return true;
+    }
+    return m_source && m_source(json);
+  }
+
+  // Complete all chunks that have their own replies.
+
+  void complete_chunks()
+  {
+    while (!m_chunks.empty() && m_chunks.front().m_reply)
+      complete_chunk();
+  }
+
+  /*
+    Wait for the reply to the first chunk on the list, accumulate its
+    affected rows, generated ids and diagnostic entries and remove it from
+    the list. Throws error reported by the server, if any.
+  */
+
+  void complete_chunk()
+  {
+    Chunk &chunk = m_chunks.front();
+    assert(chunk.m_reply);
+
+    cdk::Reply &reply = *chunk.m_reply;
+    reply.wait();
+
+    if (0 < reply.entry_count())
+    {
+      const cdk::Error &err = reply.get_error();
+      try {
+        err.rethrow();
+      }
+      catch (...)
+      {
+        m_chunks.clear();
+        throw;
+      }
+    }
+
+    m_affected_rows += reply.affected_rows();
+    const auto &ids = reply.generated_ids();
+    m_generated_ids.insert(m_generated_ids.end(), ids.begin(), ids.end());
+    Result_impl::copy_entries(reply, m_entries);
+
+    m_chunks.pop_front();
+  }
+
 };
 
 
@@ -2086,17 +2607,9 @@ inline
 void Op_collection_add::process(cdk::Expression::Processor &ep) const
 {
   assert(m_pos > 0);  // this method should be called after calling next()
+  assert(m_expr);
 
-  if (m_expr)
-  {
-    m_expr->process(ep);
-    return;
-  }
-
-  const std::string &json = m_json.at(m_pos-1);
-
-  // TODO: Report as opaque value of type DOCUMENT using JSON format.
-  ep.scalar()->val()->str(json);
+  m_expr->process(ep);
 }
 
 
@@ -2148,6 +2661,18 @@ public:
     return new Op_collection_find(*this);
   }
 
+  string get_stmt_key() override
+  {
+    string key = stmt_key("find", m_coll);
+    add_key_parts(key);
+    return key;
+  }
+
+  bool server_cursor() override
+  {
+    return m_sess->m_server_cursor;
+  }
+
   cdk::Reply* do_send_command() override
   {
     return new cdk::Reply(get_cdk_session().coll_find(
@@ -2206,6 +2731,13 @@ public:
     return new Op_collection_remove(*this);
   }
 
+  string get_stmt_key() override
+  {
+    string key = stmt_key("remove", m_coll);
+    add_key_parts(key);
+    return key;
+  }
+
 
   cdk::Reply* do_send_command() override
   {
@@ -2520,6 +3052,22 @@ class Op_table_select
     return new Op_table_select(*this);
   }
 
+  // Note: statements that create views are not shared.
+
+  std::string get_stmt_key() override
+  {
+    if (m_view)
+      return std::string();
+    std::string key = stmt_key("select", m_table);
+    add_key_parts(key);
+    return key;
+  }
+
+  bool server_cursor() override
+  {
+    return !m_view && m_sess->m_server_cursor;
+  }
+
 public:
 
   Op_table_select(Shared_session_impl sess, const cdk::api::Object_ref &table)
@@ -2884,6 +3432,13 @@ protected:
     return new Op_table_remove(*this);
   }
 
+  string get_stmt_key() override
+  {
+    string key = Base::stmt_key("delete", m_table);
+    Base::add_key_parts(key);
+    return key;
+  }
+
   cdk::Reply* do_send_command() override
   {
     return new cdk::Reply(Base::get_cdk_session().table_delete(
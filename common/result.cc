@@ -75,6 +75,15 @@ convert(cdk::bytes data, Format_descr<cdk::TYPE_STRING> &fd)
   if (fd.m_format.is_set())
     return { raw.begin(), raw.size() };
 
+  /*
+    Strings in utf8 encoding (which is what 8.0.14+ servers always send) are
+    kept as utf8 STRING values without decoding. Value::get_ustring()
+    converts them to utf16 only when requested.
+  */
+
+  if (is_utf8(fd))
+    return std::string((const char*)raw.begin(), raw.size());
+
   auto &codec = fd.m_codec;
   cdk::string str;
   codec.from_bytes(raw, str);
@@ -117,8 +126,10 @@ convert(cdk::bytes data, Format_descr<cdk::TYPE_FLOAT> &fd)
     return Value(val);
   }
 
-  // For other formats (DOUBLE, DECIMAL), try storing in double
-  // TODO: exact representation for DECIMAL values?
+  /*
+    For other formats (DOUBLE, DECIMAL), try storing in double. Exact
+    representation of DECIMAL values is available from Row_impl::get_decimal().
+  */
   {
     double val;
     fd.m_codec.from_bytes(data, val);
@@ -165,9 +176,13 @@ convert(cdk::bytes data, Format_descr<cdk::TYPE_DOCUMENT>&)
 Result_impl::Result_impl(Result_init &init)
   : m_sess(init.get_session()), m_reply(init.get_reply())
 {
+  m_fetch_size = m_sess->m_fetch_size;
+
   // Note: init.get_reply() can be NULL in the case of ignored server error
   m_sess->register_result(this);
   init.init_result(*this);
+
+  m_prefetch_size = initial_prefetch_size(m_fetch_size);
 }
 
 
@@ -175,7 +190,16 @@ Result_impl::~Result_impl()
 {
   try {
     if (m_sess)
+    {
+      /*
+        Deleting the reply closes a suspended server-side cursor, which
+        requires sending a command to the server.
+      */
+
+      if (m_cursor && m_cursor->is_suspended())
+        m_sess->resume_result(this);
       m_sess->deregister_result(this);
+    }
   }
   catch (...)
   {}
@@ -206,6 +230,8 @@ bool Result_impl::read_next_result()
   if (m_pending_rows)
   {
     assert(m_cursor);
+    if (m_cursor->is_suspended())
+      m_sess->resume_result(this);
     m_cursor->close();
   }
 
@@ -246,15 +272,12 @@ void Result_impl::push_row_cache()
 {
   m_result_mdata.push(Shared_meta_data(new Meta_data(*m_cursor)));
   m_result_cache.push(Row_cache());
-  m_result_cache_size.push(0);
 }
 
 
 const Row_data* Result_impl::get_row()
 {
-  // TODO: Session parameter for cache prefetch size
-
-  load_cache(16);
+  load_cache(m_prefetch_size);
 
   if (m_result_cache.empty() || m_result_cache.front().empty())
   {
@@ -265,7 +288,6 @@ const Row_data* Result_impl::get_row()
 
   m_row = m_result_cache.front().front();
   m_result_cache.front().pop_front();
-  m_result_cache_size.front()--;
   return &m_row;
 }
 
@@ -295,12 +317,17 @@ bool Result_impl::load_cache(row_count_t prefetch_size)
     return false;
 
   /*
-    Note: if cache is not empty then m_cache_it correctly points at the last
-    element in the cache.
+    If rows are streamed from a server-side cursor which was suspended,
+    other commands could have been sent in the meantime. Before fetching
+    more rows this result must become the current one again.
   */
 
-  if (m_result_cache.back().empty())
-    m_cache_it = m_result_cache.back().before_begin();
+  if (m_cursor->is_suspended())
+    m_sess->resume_result(this);
+
+  // Rows read by this call are stored in a new batch.
+
+  m_batch = &m_result_cache.back().new_batch();
 
   // Initiate row reading operation
 
@@ -313,6 +340,9 @@ bool Result_impl::load_cache(row_count_t prefetch_size)
 
   m_cursor->wait();
 
+  if (0 < prefetch_size && 0 == m_fetch_size)
+    adjust_prefetch_size();
+
   /*
     Cleanup after reading all rows.
   */
@@ -323,36 +353,70 @@ bool Result_impl::load_cache(row_count_t prefetch_size)
     m_sess->deregister_result(this);
     m_pending_rows = false;
   }
+  else if (m_cursor->is_suspended())
+  {
+    /*
+      The server-side cursor keeps remaining rows, so other commands can be
+      sent to the server before more rows are fetched.
+    */
+
+    m_sess->suspend_result(this);
+  }
 
   return !m_result_cache.back().empty();
 }
 
 
+void Result_impl::adjust_prefetch_size()
+{
+  assert(m_batch);
+
+  if (0 == m_batch->row_count())
+    return;
+
+  size_t row_size = m_batch->mem_size() / m_batch->row_count();
+  row_count_t size = max_batch_size / (row_size ? row_size : 1);
+
+  if (size > 2 * m_prefetch_size)
+    size = 2 * m_prefetch_size;
+  if (size > max_prefetch_size)
+    size = max_prefetch_size;
+  if (size < min_prefetch_size)
+    size = min_prefetch_size;
+
+  m_prefetch_size = size;
+}
+
+
 //  Row_processor interface implementation
 
 
-size_t Result_impl::field_begin(col_count_t pos, size_t size)
+bool Result_impl::row_begin(row_count_t)
 {
-  //m_row.insert(std::pair<col_count_t, Buffer>(pos, Buffer()));
-  m_row.emplace(pos, Buffer());
-  // FIX
-  return size;
+  assert(m_batch);
+  m_batch->row_begin(m_result_mdata.back()->col_count());
+  return true;
 }
 
 size_t Result_impl::field_data(col_count_t pos, bytes data)
 {
-  m_row[(unsigned)pos].append(data);
+  m_batch->field_data(pos, data);
   // FIX
   return data.size();
 }
 
 void Result_impl::row_end(row_count_t)
 {
-  if (!m_row_filter(m_row))
+  Row_cache &cache = m_result_cache.back();
+
+  if (m_row_filter
+      && !m_row_filter(Row_data(cache.last_batch(), m_batch->row_count() - 1)))
+  {
+    m_batch->row_drop();
     return;
+  }
 
-  m_cache_it = m_result_cache.back().emplace_after(m_cache_it, std::move(m_row));
-  m_result_cache_size.back()++;
+  cache.row_added();
 }
 
 void Result_impl::end_of_data()
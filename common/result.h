@@ -43,6 +43,8 @@
 
 PUSH_SYS_WARNINGS
 #include <queue>
+#include <deque>
+#include <memory>
 POP_SYS_WARNINGS
 
 
@@ -147,6 +149,25 @@ public:
 };
 
 
+/*
+  Check if string values in the given format use utf8 encoding, in which
+  case their raw bytes can be used without decoding them.
+*/
+
+inline
+bool is_utf8(const Format_descr<cdk::TYPE_STRING> &fd)
+{
+  switch (fd.m_format.charset())
+  {
+  case cdk::Charset::utf8:
+  case cdk::Charset::utf8mb4:
+    return true;
+  default:
+    return false;
+  }
+}
+
+
 /*
   Format_descr<T> specializations for different types.
 */
@@ -507,38 +528,247 @@ Meta_data::Meta_data(cdk::Meta_data &md)
 
 
 /*
-  Convenience wrapper around std container that is used
-  to store incoming raw bytes sequence.
+  Storage for a batch of rows received from the server.
+
+  Raw bytes of all fields of all rows in the batch are stored in a single
+  contiguous arena (m_data). For each field of each row there is an entry
+  in m_fields which gives position and size of field's bytes inside
+  the arena - fields of consecutive rows follow each other in this array.
+  Entry in m_rows gives position of the first field of the row inside
+  m_fields. Field of size 0 is a null value.
+
+  A batch is filled with rows using row_begin(), field_data() and
+  row_end() methods. Once filled, the batch is not modified any more and
+  Row_data instances give read-only views of its rows. Batches are shared
+  between such views and the row cache of a result (see Row_cache), so that
+  batch data stays valid as long as there are rows referring to it.
+*/
+
+class Row_batch
+{
+  struct Field
+  {
+    size_t m_begin;
+    size_t m_size;
+  };
+
+  std::vector<byte>    m_data;
+  std::vector<Field>   m_fields;
+  std::vector<size_t>  m_rows;
+
+public:
+
+  size_t row_count() const
+  {
+    return m_rows.size();
+  }
+
+  // Approximate memory used by the batch.
+
+  size_t mem_size() const
+  {
+    return m_data.size() + m_fields.size()*sizeof(Field)
+           + m_rows.size()*sizeof(size_t);
+  }
+
+  col_count_t col_count(size_t row) const
+  {
+    assert(row < m_rows.size());
+    size_t end = row + 1 < m_rows.size() ? m_rows[row + 1] : m_fields.size();
+    return (col_count_t)(end - m_rows[row]);
+  }
+
+  // Returns empty bytes if the field is null.
+
+  cdk::bytes get(size_t row, col_count_t pos) const
+  {
+    assert(pos < col_count(row));
+    const Field &fld = m_fields[m_rows[row] + pos];
+    if (0 == fld.m_size)
+      return cdk::bytes();
+    byte *data = const_cast<byte*>(m_data.data());
+    return cdk::bytes(data + fld.m_begin, fld.m_size);
+  }
+
+  /*
+    Start new row with given number of fields, all of them initially null.
+    More fields are added if field_data() is called for them.
+  */
+
+  void row_begin(col_count_t col_count)
+  {
+    m_rows.push_back(m_fields.size());
+    m_fields.resize(m_fields.size() + col_count, Field{ 0, 0 });
+  }
+
+  /*
+    Append data to the given field of the current row. Fields of a row
+    must be filled in order.
+  */
+
+  void field_data(col_count_t pos, cdk::bytes data)
+  {
+    assert(!m_rows.empty());
+
+    if (m_rows.back() + pos >= m_fields.size())
+      m_fields.resize(m_rows.back() + pos + 1, Field{ 0, 0 });
+
+    Field &fld = m_fields[m_rows.back() + pos];
+    if (0 == fld.m_size)
+      fld.m_begin = m_data.size();
+    assert(fld.m_begin + fld.m_size == m_data.size());
+    m_data.insert(m_data.end(), data.begin(), data.end());
+    fld.m_size += data.size();
+  }
+
+  // Remove the last row from the batch.
+
+  void row_drop()
+  {
+    assert(!m_rows.empty());
+
+    size_t data_end = m_data.size();
 
-  TODO: More efficient implementation.
+    for (size_t i = m_rows.back(); i < m_fields.size(); ++i)
+    {
+      if (0 < m_fields[i].m_size)
+      {
+        data_end = m_fields[i].m_begin;
+        break;
+      }
+    }
+
+    m_data.resize(data_end);
+    m_fields.resize(m_rows.back());
+    m_rows.pop_back();
+  }
+};
+
+using Shared_row_batch = std::shared_ptr<const Row_batch>;
+
+
+/*
+  Raw data of a single row. This is a light-weight view of a row stored
+  inside a Row_batch. Copying it does not copy row data but shares
+  the batch.
+
+  Method at() returns raw bytes of a non-null field and throws
+  std::out_of_range if the field is null (or does not exist), method get()
+  returns empty bytes in that case.
 */
 
-class Buffer
+class Row_data
 {
-  std::vector<byte> m_impl;
+  Shared_row_batch  m_batch;
+  size_t            m_row = 0;
 
 public:
 
-  void append(cdk::bytes data)
+  Row_data() = default;
+
+  Row_data(const Shared_row_batch &batch, size_t row)
+    : m_batch(batch), m_row(row)
   {
-    m_impl.insert(m_impl.end(), data.begin(), data.end());
+    assert(m_row < m_batch->row_count());
   }
 
-  size_t size() const { return m_impl.size(); }
+  col_count_t size() const
+  {
+    return m_batch ? m_batch->col_count(m_row) : 0;
+  }
+
+  cdk::bytes get(col_count_t pos) const
+  {
+    if (pos >= size())
+      return cdk::bytes();
+    return m_batch->get(m_row, pos);
+  }
+
+  cdk::bytes at(col_count_t pos) const
+  {
+    cdk::bytes data = get(pos);
+    if (0 == data.size())
+      throw std::out_of_range("row column");
+    return data;
+  }
 
-  cdk::bytes data() const
+  void clear()
   {
-    return cdk::bytes((byte*)m_impl.data(), m_impl.size());
+    m_batch.reset();
+    m_row = 0;
   }
 };
 
 
 /*
-  Data structure used to hold raw row data. It holds a Buffer with
-  raw bytes for each non-null field of a row.
+  Cache of rows received from the server, consisting of a sequence of
+  row batches. Rows are added by filling a batch created with new_batch()
+  and consumed from the front with front() and pop_front().
 */
 
-typedef std::map<col_count_t, Buffer> Row_data;
+class Row_cache
+{
+  std::deque<std::shared_ptr<Row_batch>> m_batches;
+
+  // Position of the first not consumed row inside the front batch.
+
+  size_t       m_pos = 0;
+  row_count_t  m_size = 0;
+
+public:
+
+  bool empty() const { return 0 == m_size; }
+  row_count_t size() const { return m_size; }
+
+  /*
+    Append new empty batch to the cache and return reference to it. It is
+    assumed that all rows added to the batch are not filtered out are
+    reported with row_added().
+  */
+
+  Row_batch& new_batch()
+  {
+    m_batches.emplace_back(std::make_shared<Row_batch>());
+    return *m_batches.back();
+  }
+
+  const std::shared_ptr<Row_batch>& last_batch() const
+  {
+    assert(!m_batches.empty());
+    return m_batches.back();
+  }
+
+  void row_added()
+  {
+    ++m_size;
+  }
+
+  Row_data front()
+  {
+    assert(!empty());
+    skip_consumed();
+    return Row_data(m_batches.front(), m_pos);
+  }
+
+  void pop_front()
+  {
+    assert(!empty());
+    skip_consumed();
+    ++m_pos;
+    --m_size;
+  }
+
+private:
+
+  void skip_consumed()
+  {
+    while (m_pos >= m_batches.front()->row_count())
+    {
+      m_batches.pop_front();
+      m_pos = 0;
+    }
+  }
+};
 
 
 /*
@@ -572,7 +802,10 @@ public:
 
   Row_impl() {};
 
-  // Note: row data is copied into Row_impl instance
+  /*
+    Note: row data is not copied - Row_impl instance refers to the row
+    batch that holds it.
+  */
 
   Row_impl(const Row_data &data, const Shared_meta_data &md)
     : m_data(data), m_mdata(md)
@@ -582,7 +815,14 @@ protected:
 
   Row_data          m_data;
   Shared_meta_data  m_mdata;
-  std::map<col_count_t, Value>    m_vals;
+
+  /*
+    Converted values are stored in m_vals vector, m_has_val[pos] tells
+    if value at given position is present in it.
+  */
+
+  std::vector<Value>              m_vals;
+  std::vector<bool>               m_has_val;
   col_count_t                     m_col_count = 0;
 
 public:
@@ -591,6 +831,7 @@ public:
   {
     m_data.clear();
     m_vals.clear();
+    m_has_val.clear();
     m_mdata.reset();
   }
 
@@ -604,14 +845,63 @@ public:
     if (m_mdata && pos >= m_mdata->col_count())
       throw std::out_of_range("row column");
 
-    try {
-      return m_data.at(pos).data();
-    }
-    catch (const std::out_of_range&)
-    {
-      // empty bytes indicate null value
-      return bytes();
-    }
+    // empty bytes indicate null value
+    return m_data.get(pos);
+  }
+
+  /*
+    Get utf8 encoding of a string field at given position without decoding
+    or copying it. The trailing 0x00 byte (see convert()) is not included.
+    Returns empty bytes for null value.
+    @throws Error if the field does not hold a string in utf8 encoding.
+  */
+
+  bytes get_utf8(col_count_t pos) const
+  {
+    bytes raw = get_bytes(pos);
+
+    if (0 == raw.size())
+      return raw;
+
+    if (!m_mdata)
+      throw std::out_of_range("row column");
+
+    const Format_info &fi = m_mdata->get_format(pos);
+
+    if (cdk::TYPE_STRING != fi.m_type || !is_utf8(fi.get<cdk::TYPE_STRING>()))
+      THROW("Field does not hold a utf8 string");
+
+    return bytes(raw.begin(), raw.end() - 1);
+  }
+
+  /*
+    Decode DECIMAL field at given position into its exact representation.
+    Returns false for null value.
+    @throws Error if the field does not hold a DECIMAL value.
+  */
+
+  bool get_decimal(col_count_t pos, cdk::Decimal &val) const
+  {
+    bytes raw = get_bytes(pos);
+
+    if (0 == raw.size())
+      return false;
+
+    if (!m_mdata)
+      throw std::out_of_range("row column");
+
+    const Format_info &fi = m_mdata->get_format(pos);
+
+    if (cdk::TYPE_FLOAT != fi.m_type)
+      THROW("Field does not hold a DECIMAL value");
+
+    auto &fd = fi.get<cdk::TYPE_FLOAT>();
+
+    if (fd.m_format.DECIMAL != fd.m_format.type())
+      THROW("Field does not hold a DECIMAL value");
+
+    fd.m_codec.from_bytes(raw, val);
+    return true;
   }
 
   /*
@@ -624,55 +914,59 @@ public:
     if (m_mdata && pos >= m_mdata->col_count())
       throw std::out_of_range("row column");
 
-    try {
-      return m_vals.at(pos);
-    }
-    catch (const std::out_of_range&)
-    {
-      if (!m_mdata)
-        throw;
-      const Format_info &fi = m_mdata->get_format(pos);
-      convert_at(pos, fi);
-      return m_vals.at(pos);
-    }
+    if (pos < m_has_val.size() && m_has_val[pos])
+      return m_vals[pos];
+
+    if (!m_mdata)
+      throw std::out_of_range("row column");
+
+    const Format_info &fi = m_mdata->get_format(pos);
+    convert_at(pos, fi);
+    return m_vals[pos];
   }
 
   void set(col_count_t pos, const Value &val)
   {
-    m_vals.emplace(pos, val);
+    if (pos < m_has_val.size() && m_has_val[pos])
+      return;
+    alloc_val(pos) = val;
     if (pos >= m_col_count)
       m_col_count = pos + 1;
   }
 
 private:
 
-  void convert_at(col_count_t pos, const Format_info &fi)
+  Value& alloc_val(col_count_t pos)
   {
-    Buffer *raw = nullptr;
-
-    try {
-      raw = &m_data.at(pos);
+    if (pos >= m_vals.size())
+    {
+      col_count_t size = std::max(pos + 1, col_count());
+      m_vals.resize(size);
+      m_has_val.resize(size, false);
     }
-    catch (const std::out_of_range&)
-    {}
+    m_has_val[pos] = true;
+    return m_vals[pos];
+  }
+
+  void convert_at(col_count_t pos, const Format_info &fi)
+  {
+    bytes raw = m_data.get(pos);
 
-    if (!raw || 0 == raw->size())
+    if (0 == raw.size())
     {
       // Null value
-      m_vals.emplace(pos, Value());
+      alloc_val(pos) = Value();
       return;
     }
 
     /*
       Call static function VAL::Access:mk() to construct VAL instance from
-      raw bytes and put it into m_vals map. Aprropriate encoding format
+      raw bytes and put it into m_vals vector. Aprropriate encoding format
       information is extracted from fi.
     */
 
 #define CONVERT(T) case cdk::TYPE_##T: \
-    m_vals.emplace(pos, \
-      VAL::Access::mk(raw->data(), fi.get<cdk::TYPE_##T>()) \
-    ); \
+    alloc_val(pos) = VAL::Access::mk(raw, fi.get<cdk::TYPE_##T>()); \
     break;
 
     switch (fi.m_type)
@@ -783,6 +1077,8 @@ namespace common {
 
 using impl::common::Shared_meta_data;
 using impl::common::Row_data;
+using impl::common::Row_batch;
+using impl::common::Row_cache;
 using impl::common::Column_info;
 
 /*
@@ -855,6 +1151,16 @@ public:
 
   bool next_result();
 
+  /*
+    Number of rows loaded into the cache by the first get_row() call for
+    a session with given fetch size (see m_prefetch_size).
+  */
+
+  static row_count_t initial_prefetch_size(row_count_t fetch_size)
+  {
+    return 0 < fetch_size ? fetch_size : min_prefetch_size;
+  }
+
   /*
     Returns true if the current result has (more) rows to be fetched.
   */
@@ -910,17 +1216,53 @@ public:
   unsigned get_warning_count() const;
 
   /*
-    Client-side filtering of row data. Function m_row_filter is applied
-    for each received row to determine if it should be skipped.
+    Client-side filtering of row data. Function m_row_filter, if set, is
+    applied for each received row to determine if it should be skipped.
   */
 
   using Row_filter_t = std::function<bool(const Row_data&)>;
-  Row_filter_t m_row_filter = [](const Row_data&) { return true; };
+  Row_filter_t m_row_filter;
 
   // Get generated document id information.
 
   const std::vector<std::string>& get_generated_ids() const;
 
+  /*
+    Affected rows count and generated ids that are combined with the ones
+    reported by the reply. They come from replies to other commands sent
+    by the same operation (see Op_collection_add). If m_generated_ids is
+    not empty, it contains all ids generated by the operation.
+  */
+
+  cdk::row_count_t m_more_affected_rows = 0;
+  std::vector<std::string> m_generated_ids;
+
+  /*
+    Fetch size used for this result: the FETCH_SIZE option of the session,
+    unless overridden by the operation (see Op_base::init_result()).
+  */
+
+  row_count_t m_fetch_size = 0;
+
+  /*
+    Add copies of all diagnostic entries from the given source to the ones
+    reported by this result. Entries added this way precede those reported
+    by the reply (see Op_collection_add).
+  */
+
+  void add_entries(cdk::api::Diagnostics &diag)
+  {
+    copy_entries(diag, m_more_entries);
+  }
+
+  static void copy_entries(cdk::api::Diagnostics &from,
+                           cdk::Diagnostic_arena &to)
+  {
+    auto &it = from.get_entries(Severity::INFO);
+    while (it.next())
+      to.add_entry(it.entry().severity(), it.entry().get_error().clone());
+  }
+
   /*
     Get column information.
 
@@ -992,13 +1334,34 @@ protected:
   cdk::Reply  *m_reply;
   cdk::Cursor *m_cursor = nullptr;
 
-  using Row_cache = std::forward_list<Row_data>;
-
   // Each queue elements represents a resultset.
 
   std::queue<Row_cache> m_result_cache;
-  std::queue<row_count_t> m_result_cache_size;
-  Row_cache::iterator m_cache_it;
+
+  /*
+    Batch into which rows are stored while reading them from the server.
+    New batch is created for each load_cache() call.
+  */
+
+  Row_batch *m_batch = nullptr;
+
+  /*
+    Number of rows loaded into the cache by get_row() when the cache is
+    empty. If session has fetch size set, it is used as prefetch size.
+    Otherwise prefetch size starts at min_prefetch_size and is adjusted after
+    each load by adjust_prefetch_size() so that a batch takes around
+    max_batch_size bytes, but it grows at most twice each time. This way
+    wide rows are read in small batches, while for narrow rows we do not
+    have to wait for the server after each few rows.
+  */
+
+  static const row_count_t min_prefetch_size = 16;
+  static const row_count_t max_prefetch_size = 64*1024;
+  static const size_t max_batch_size = 1024*1024;
+
+  row_count_t m_prefetch_size = min_prefetch_size;
+
+  void adjust_prefetch_size();
 
   /*
     Ensure some rows are loaded into the cache. If cache is not empty, it
@@ -1024,27 +1387,9 @@ protected:
       m_result_mdata.pop();
     if (!m_result_cache.empty())
     {
-      /*
-        At this point m_cache_it can point inside the last entry of
-        m_result_cache that is just to be removed. Such dangling iterator
-        can cause issues when later it is assigned to a new value (as
-        compiler thinks it is still pointing inside old container and might
-        want to do some cleanups). To avoid dangling iterator, we reset it
-        to something neutral here.
-
-        Note: This "fix" works under assumption that "one past the end"
-        iterator is compatible between different containers, which seems to
-        be the case for all compilers we use.
-
-        TODO: A better solution would be to use std::option<> type for
-        m_cache_it.
-      */
-
-      m_cache_it = m_result_cache.back().end();
+      m_batch = nullptr;
       m_result_cache.pop();
     }
-    if (!m_result_cache_size.empty())
-      m_result_cache_size.pop();
   }
 
   // Called on each resultset to be read.
@@ -1061,7 +1406,10 @@ public:
     if (!m_reply)
       THROW("Attempt to get warning count for empty result");
 
-    return m_reply->entry_count(level);
+    if (m_entries_merged)
+      return m_more_entries.entry_count(level);
+
+    return m_reply->entry_count(level) + m_more_entries.entry_count(level);
   }
 
   // Get an iterator to iterate over diagnostic entries with level above or equal to given one
@@ -1073,7 +1421,25 @@ public:
     if (!m_reply)
       THROW("Attempt to get warning count for empty result");
 
-    return m_reply->get_entries(level);
+    if (0 == m_more_entries.entry_count(Severity::INFO)
+        + m_more_entries.entry_count(Severity::WARNING)
+        + m_more_entries.entry_count(Severity::ERROR))
+      return m_reply->get_entries(level);
+
+    /*
+      To iterate over all entries, the ones reported by the reply are copied
+      after the entries added with add_entries(). This is done once, when
+      the reply is complete.
+    */
+
+    if (!m_entries_merged)
+    {
+      m_reply->wait();
+      copy_entries(*m_reply, m_more_entries);
+      m_entries_merged = true;
+    }
+
+    return m_more_entries.get_entries(level);
   }
 
   // Convenience method to return first error entry (if any).
@@ -1088,19 +1454,18 @@ public:
 
 private:
 
+  cdk::Diagnostic_arena m_more_entries;
+  bool m_entries_merged = false;
+
   // Row_processor
 
   Row_data    m_row;
 
-  bool row_begin(row_count_t) override
-  {
-    m_row.clear();
-    return true;
-  }
+  bool row_begin(row_count_t) override;
 
   void row_end(row_count_t) override;
 
-  size_t field_begin(col_count_t pos, size_t) override;
+  size_t field_begin(col_count_t, size_t size) override { return size; }
   void   field_end(col_count_t) override {}
   void   field_null(col_count_t) override {}
   size_t field_data(col_count_t pos, bytes) override;
@@ -1122,7 +1487,7 @@ cdk::row_count_t Result_impl::get_affected_rows() const
 {
   if (!m_reply)
     THROW("Attempt to get affected rows count on empty result");
-  return m_reply->affected_rows();
+  return m_reply->affected_rows() + m_more_affected_rows;
 }
 
 inline
@@ -1145,6 +1510,8 @@ const std::vector<std::string>& Result_impl::get_generated_ids() const
 {
   if (!m_reply)
     THROW("Attempt to get generated ids for empty result");
+  if (!m_generated_ids.empty())
+    return m_generated_ids;
   return m_reply->generated_ids();
 }
 
@@ -1183,8 +1550,8 @@ row_count_t Result_impl::count()
   if (entry_count() > 0)
     get_error().rethrow();
   row_count_t rc = 0;
-  if(!m_result_cache_size.empty())
-    rc = m_result_cache_size.front();
+  if(!m_result_cache.empty())
+    rc = m_result_cache.front().size();
   return rc;
 }
 
@@ -34,6 +34,7 @@
 #include <mysqlx/common.h>
 
 PUSH_SYS_WARNINGS
+#include <algorithm>
 #include <chrono>
 #include <ratio>
 #include <thread>
@@ -243,6 +244,26 @@ TLS_options::SSL_MODE get_ssl_mode(unsigned m)
   return CDK_type(0); // quiet compiler warnings
 }
 
+TCPIP_options::compression_mode_t get_compression_mode(unsigned m)
+{
+  using DevAPI_type = Settings_impl::Compression_mode;
+  using CDK_type = TCPIP_options::compression_mode_t;
+
+  switch (DevAPI_type(m))
+  {
+#define COMPRESSION_TO_CDK(X,N) \
+  case DevAPI_type::X: return CDK_type::X;
+
+    COMPRESSION_MODE_LIST(COMPRESSION_TO_CDK)
+
+  default:
+    // Note: caller should ensure that argument has correct value
+    assert(false);
+  }
+
+  return CDK_type(0); // quiet compiler warnings
+}
+
 
 /*
   Initialize CDK connection options based on session settings.
@@ -371,6 +392,19 @@ void prepare_options(
     );
   }
 
+  // Set compression options
+
+  if (settings.has_option(Option::COMPRESSION))
+    opts.set_compression(get_compression_mode(
+      (unsigned)settings.get(Option::COMPRESSION).get_uint()
+    ));
+
+  for (const auto &opt_val : settings)
+  {
+    if (Option::COMPRESSION_ALGORITHMS == opt_val.first)
+      opts.add_compression_algorithm(opt_val.second.get_string());
+  }
+
   // DNS+SRV
 
   if(settings.has_option(Option::DNS_SRV))
@@ -596,6 +630,54 @@ void Settings_impl::get_attributes(cdk::ds::Attr_processor &prc)
 // ---------------------------------------------------------------------------
 
 
+void Session_impl::set_options(Settings_impl &opts)
+{
+  if (opts.has_option(Settings_impl::Session_option_impl::FETCH_SIZE))
+    m_fetch_size = opts.get(Settings_impl::Session_option_impl::FETCH_SIZE)
+                   .get_uint();
+  if (opts.has_option(Settings_impl::Session_option_impl::SERVER_CURSOR))
+    m_server_cursor =
+      opts.get(Settings_impl::Session_option_impl::SERVER_CURSOR).get_bool();
+}
+
+
+void Session_impl::begin_pipeline()
+{
+  prepare_for_cmd();
+  m_sess->begin_pipeline();
+}
+
+
+void Session_impl::send_pipeline()
+{
+  m_sess->send_pipeline();
+}
+
+
+unsigned Session_impl::get_fd()
+{
+  return m_sess->get_fd();
+}
+
+
+bool Session_impl::wants_read()
+{
+  return m_sess->wants_read();
+}
+
+
+bool Session_impl::wants_write()
+{
+  return m_sess->wants_write();
+}
+
+
+void Session_impl::progress()
+{
+  m_sess->progress();
+}
+
+
 void Session_impl::prepare_for_cmd()
 {
   if (m_current_result)
@@ -604,6 +686,12 @@ void Session_impl::prepare_for_cmd()
   }
 
   m_current_result = nullptr;
+
+  while (!m_sent_ops.empty() && !m_sent_ops.front().m_op)
+  {
+    std::unique_ptr<cdk::Reply> reply(m_sent_ops.front().m_reply);
+    m_sent_ops.pop_front();
+  }
 }
 
 
@@ -615,15 +703,98 @@ void Session_impl::release()
 }
 
 
+void Session_impl::stmt_cache_insert(const std::string &key,
+                                     const Shared_stmt_id &id)
+{
+  m_stmt_cache.push_front({ key, id });
+  m_stmt_cache_map[key] = m_stmt_cache.begin();
+
+  if (m_stmt_cache.size() <= c_stmt_cache_size)
+    return;
+
+  /*
+    Evict the least recently used entry. If no operation uses its statement
+    id anymore, the id is released so that the statement gets deallocated.
+    Otherwise the last operation using it will release it.
+  */
+
+  Stmt_entry &last = m_stmt_cache.back();
+
+  if (last.m_id && last.m_id.unique())
+    release_stmt_id(*last.m_id);
+
+  m_stmt_cache_map.erase(last.m_key);
+  m_stmt_cache.pop_back();
+}
+
+
+bool Session_impl::find_stmt(const std::string &key, Shared_stmt_id &id)
+{
+  auto it = m_stmt_cache_map.find(key);
+
+  if (it == m_stmt_cache_map.end())
+  {
+    stmt_cache_insert(key, nullptr);
+    id.reset();
+    return false;
+  }
+
+  m_stmt_cache.splice(m_stmt_cache.begin(), m_stmt_cache, it->second);
+  id = it->second->m_id;
+  return true;
+}
+
+
+void Session_impl::cache_stmt(const std::string &key, const Shared_stmt_id &id)
+{
+  auto it = m_stmt_cache_map.find(key);
+
+  if (it == m_stmt_cache_map.end())
+  {
+    stmt_cache_insert(key, id);
+    return;
+  }
+
+  m_stmt_cache.splice(m_stmt_cache.begin(), m_stmt_cache, it->second);
+  it->second->m_id = id;
+}
+
+
+void Session_impl::uncache_stmt(const Shared_stmt_id &id)
+{
+  for (Stmt_entry &entry : m_stmt_cache)
+  {
+    if (entry.m_id == id)
+      entry.m_id.reset();
+  }
+}
+
+
 // ---------------------------------------------------------------------------
 
 
+/*
+  Returns the time point after given duration from now. Note that adding
+  duration::max() directly would overflow.
+*/
+
+static time_point deadline_after(duration d)
+{
+  time_point now = system_clock::now();
+
+  if (d >= std::chrono::duration_cast<duration>(time_point::max() - now))
+    return time_point::max();
+
+  return now + d;
+}
+
+
 Pooled_session::Pooled_session(
   Session_pool_shared &pool, Session_cleanup *cleanup
 )
   : m_sess_pool(pool), m_cleanup(cleanup)
 {
-  m_deadline = system_clock::now() + m_sess_pool->m_timeout;
+  m_deadline = deadline_after(m_sess_pool->m_timeout);
   cont();
 }
 
@@ -734,10 +905,18 @@ catch (...)
 
 void Session_pool::close()
 {
+  // Note: maintenance thread can use pool sessions, so it is stopped first.
+
+  stop_maintenance();
+
   lock_guard guard(m_pool_mutex);
   //First, close all sessions
   for(auto &el : m_pool)
   {
+    // Session which is being reset by get_session() is closed there.
+    if (el.second.m_in_reset)
+      continue;
+
     try{
       // If there is a cleanup handler, call it before closing a session.
       if (el.second.m_cleanup)
@@ -748,6 +927,10 @@ void Session_pool::close()
       assert(false);
     }
   }
+  m_idle.clear();
+  m_idle_checked.clear();
+  m_released.clear();
+  m_busy.clear();
   m_pool.clear();
 
   //prevent changing m_pool_closed before getting release condition signal
@@ -765,6 +948,10 @@ void Session_pool::release_session(cdk::shared_ptr<cdk::Session> &sess)
   // Pool closed... nothing to do here!
   if (m_pool_closed)
     return;
+
+  // Note: expired sessions are destroyed after releasing the lock.
+  Session_list expired;
+
   {
     lock_guard guard(m_pool_mutex);
 
@@ -772,7 +959,7 @@ void Session_pool::release_session(cdk::shared_ptr<cdk::Session> &sess)
 
     if (el != m_pool.end())
     {
-      el->second.m_deadline = system_clock::now() + m_time_to_live;
+      el->second.m_deadline = deadline_after(m_time_to_live);
 
       // Note: we assume that session returned to the pool is no longer
       // in use and does not need a cleanup handler.
@@ -782,99 +969,521 @@ void Session_pool::release_session(cdk::shared_ptr<cdk::Session> &sess)
     try {
       //Reset session so that internal is unique!
       sess.reset();
+
+      /*
+        The session will be reset by the maintenance thread before it is
+        given away again. If it is still referenced elsewhere, it waits in
+        m_busy until the other references are gone.
+      */
+
+      if (el != m_pool.end())
+      {
+        if (el->first.unique())
+          m_released.push_front(el);
+        else
+          m_busy.push_back(el);
+      }
     }
     catch (...) {
       try {
         //remove session, since we got error
-        m_pool.erase(el);
+        if (el != m_pool.end())
+          m_pool.erase(el);
       } catch (...)
       {}
     }
 
-    time_to_live_cleanup();
+    release_busy();
+    time_to_live_cleanup(expired);
+  }
+
+  {
+    std::lock_guard<std::mutex> guard(m_maint_mutex);
+    m_maint_wakeup = true;
   }
+  m_maint_cond.notify_one();
 
   //inform a session was released
   m_release_cond.notify_one();
 }
 
 
+/*
+  Close session that was reset or created for a pool which got closed
+  in the meantime.
+*/
+
+static void close_session(std::shared_ptr<cdk::Session> &sess)
+{
+  try {
+    sess->close();
+  }
+  catch (...)
+  {}
+}
+
+
+/*
+  Reset session and tell if it is still valid afterwards.
+*/
+
+static bool reset_session(std::shared_ptr<cdk::Session> &sess)
+{
+  try {
+    sess->reset();
+    return sess->is_valid();
+  }
+  catch (...)
+  {}
+  return false;
+}
+
+
+/*
+  Tell if an idle session is still alive. This is a cheap check which,
+  unlike reset_session(), does not send anything to the server: it only
+  detects (without blocking) that the server has closed the connection.
+*/
+
+static bool check_session(std::shared_ptr<cdk::Session> &sess)
+{
+  try {
+    return sess->check_valid();
+  }
+  catch (...)
+  {}
+  return false;
+}
+
+
 std::shared_ptr<cdk::Session>
 Session_pool::get_session(Session_cleanup *cleanup)
 {
-  lock_guard guard(m_pool_mutex);
+  // Note: m_pool_enable is set only when the pool is configured.
 
   if (!m_pool_enable)
-  {
     return std::shared_ptr<cdk::Session>(new cdk::Session(m_ds));
+
+  std::shared_ptr<cdk::Session> sess;
+  Session_list expired;
+
+  {
+    lock_guard guard(m_pool_mutex);
+
+    if (m_pool_closed)
+      throw_error("Pool was closed!");
+
+    release_busy();
+    time_to_live_cleanup(expired);
+
+    // Sessions in the idle list were already reset and can be used directly.
+
+    if (!m_idle.empty())
+    {
+      auto el = std::prev(m_idle.end())->second;
+      idle_erase(el);
+      el->second.m_cleanup = cleanup;
+      return el->first;
+    }
+
+    // Otherwise take the most recently released session and reset it here.
+
+    if (!m_released.empty())
+    {
+      auto el = m_released.front();
+      m_released.pop_front();
+      sess = el->first;
+      el->second.m_in_reset = true;
+    }
+
+    // Reserve a slot for a new connection if there is no idle one.
+
+    if (!sess)
+    {
+      if (m_pool.size() + m_pending >= m_max)
+        return nullptr;
+      ++m_pending;
+    }
+  }
+
+  if (sess)
+  {
+    bool valid = reset_session(sess);
+
+    lock_guard guard(m_pool_mutex);
+
+    if (m_pool_closed)
+    {
+      close_session(sess);
+      throw_error("Pool was closed!");
+    }
+
+    auto el = m_pool.find(sess);
+    assert(el != m_pool.end());
+
+    if (valid)
+    {
+      el->second.m_in_reset = false;
+      el->second.m_cleanup = cleanup;
+      return sess;
+    }
+
+    // Replace the session that could not be reset with a new one.
+
+    m_pool.erase(el);
+    ++m_pending;
+  }
+
+  // Need new connection -- it is created in the slot reserved above.
+
+  try {
+    sess.reset(new cdk::Session(m_ds));
+  }
+  catch (...)
+  {
+    {
+      lock_guard guard(m_pool_mutex);
+      --m_pending;
+    }
+
+    // The reserved slot is free again.
+
+    m_release_cond.notify_one();
+    throw;
   }
 
+  lock_guard guard(m_pool_mutex);
+  --m_pending;
+
   if (m_pool_closed)
+  {
+    close_session(sess);
     throw_error("Pool was closed!");
+  }
+
+  m_pool.emplace(sess,
+    Sess_data{ time_point::max(), cleanup, false, system_clock::now() }
+  );
+  return sess;
+}
+
+
+void Session_pool::time_to_live_cleanup(Session_list &expired)
+{
+  lock_guard guard(m_pool_mutex);
 
-  time_to_live_cleanup();
+  time_point current_time = system_clock::now();
+
+  /*
+    Sessions in m_released are ordered by their deadlines, the earliest one
+    at the end, and m_idle index starts with the earliest deadline. Sessions
+    are not removed if this would leave less than m_min sessions in the pool.
+
+    Note: removed session is not active and does not need calling of
+    the cleanup handler.
+  */
 
-  for(auto it = m_pool.begin();
-      it != m_pool.end();
-      ++it)
+  while (
+    !m_released.empty() && m_pool.size() + m_pending > m_min
+    && m_released.back()->second.m_deadline < current_time
+  )
   {
-    // Not in use
-    if (it->first.unique())
+    expired.push_back(m_released.back()->first);
+    m_pool.erase(m_released.back());
+    m_released.pop_back();
+  }
+
+  while (
+    !m_idle.empty() && m_pool.size() + m_pending > m_min
+    && m_idle.begin()->first < current_time
+  )
+  {
+    auto el = m_idle.begin()->second;
+    idle_erase(el);
+    expired.push_back(el->first);
+    m_pool.erase(el);
+  }
+}
+
+
+void Session_pool::release_busy()
+{
+  // Note: normally m_busy is empty or very short.
+
+  for (auto it = m_busy.begin(); it != m_busy.end();)
+  {
+    auto el = *it;
+
+    if (!el->first.unique())
     {
-      try {
-        it->first->reset();
-        if(!it->first->is_valid())
+      ++it;
+      continue;
+    }
+
+    // Time to live counts from the moment session is really released.
+
+    el->second.m_deadline = deadline_after(m_time_to_live);
+    m_released.push_front(el);
+    it = m_busy.erase(it);
+  }
+}
+
+
+/*
+  Pool maintenance
+  ----------------
+*/
+
+/*
+  How long the maintenance thread sleeps if it is not woken up by a released
+  session, and how often it checks that an idle session is still alive.
+*/
+
+static const duration c_maint_interval = std::chrono::seconds(1);
+static const duration c_check_interval = std::chrono::seconds(30);
+
+
+void Session_pool::start_maintenance()
+{
+  std::lock_guard<std::mutex> guard(m_maint_mutex);
+
+  if (m_maint_stop || m_maint_thread.joinable())
+    return;
+
+  m_maint_thread = std::thread(&Session_pool::maintenance, this);
+}
+
+
+void Session_pool::stop_maintenance()
+{
+  std::thread maint;
+
+  {
+    std::lock_guard<std::mutex> guard(m_maint_mutex);
+    m_maint_stop = true;
+    maint.swap(m_maint_thread);
+  }
+
+  m_maint_cond.notify_all();
+
+  if (maint.joinable())
+    maint.join();
+}
+
+
+void Session_pool::maintenance()
+{
+  std::unique_lock<std::mutex> lock(m_maint_mutex);
+
+  while (!m_maint_stop)
+  {
+    m_maint_wakeup = false;
+    lock.unlock();
+
+    /*
+      Each step handles a single session so that the stop request is noticed
+      soon. Released sessions are reset before new ones are created because
+      threads might be waiting for them.
+    */
+
+    try {
+      {
+        // Note: expired sessions are destroyed after releasing the lock.
+        Session_list expired;
         {
-          throw "Remove this";
+          lock_guard guard(m_pool_mutex);
+          release_busy();
+          time_to_live_cleanup(expired);
         }
-
-      } catch (...) {
-        m_pool.erase(it);
-        break;
       }
-      it->second.m_cleanup = cleanup;
-      return it->first;
+
+      while (!m_maint_stop && (reset_released() || add_min_session()))
+      {}
+
+      while (!m_maint_stop && check_idle())
+      {}
     }
+    catch (...)
+    {
+      // Errors, such as failure to connect a new session, are ignored here.
+      // The step will be repeated after c_maint_interval.
+    }
+
+    lock.lock();
+
+    if (!m_maint_stop && !m_maint_wakeup)
+      m_maint_cond.wait_for(lock, c_maint_interval);
   }
+}
+
+
+bool Session_pool::reset_released()
+{
+  std::shared_ptr<cdk::Session> sess;
 
-  // Need new connection
-  if (m_pool.size() < m_max)
   {
-    auto ret = m_pool.emplace(
-      cdk::shared_ptr<cdk::Session>(new cdk::Session(m_ds)),
-      Sess_data{ time_point::max(), cleanup }
-    );
-    return ret.first->first;
+    lock_guard guard(m_pool_mutex);
+
+    if (m_pool_closed || m_released.empty())
+      return false;
+
+    auto el = m_released.back();
+    m_released.pop_back();
+    el->second.m_in_reset = true;
+    sess = el->first;
   }
-  return nullptr;
+
+  return_idle(sess, reset_session(sess));
+  return true;
 }
 
 
-void Session_pool::time_to_live_cleanup()
+bool Session_pool::check_idle()
 {
-  lock_guard guard(m_pool_mutex);
+  std::shared_ptr<cdk::Session> sess;
+
+  {
+    lock_guard guard(m_pool_mutex);
+
+    if (m_pool_closed)
+      return false;
+
+    time_point check_time = system_clock::now() - c_check_interval;
+
+    // Note: m_idle_checked starts with the session checked least recently.
+
+    if (m_idle_checked.empty() || !(m_idle_checked.begin()->first < check_time))
+      return false;
+
+    auto el = m_idle_checked.begin()->second;
+    idle_erase(el);
+    el->second.m_in_reset = true;
+    sess = el->first;
+  }
+
+  return_idle(sess, check_session(sess));
+  return true;
+}
 
-  time_point current_time = system_clock::now();
 
-  auto it = m_pool.begin();
-  for(; it != m_pool.end(); )
+/*
+  Put a session which was reset or checked by the maintenance thread (with
+  m_in_reset flag set) back into m_idle, or remove it from the pool if it is
+  no longer valid.
+*/
+
+void Session_pool::return_idle(std::shared_ptr<cdk::Session> &sess, bool valid)
+{
   {
-    if (it->first.unique() && it->second.m_deadline < current_time)
+    lock_guard guard(m_pool_mutex);
+
+    if (m_pool_closed)
+    {
+      close_session(sess);
+      return;
+    }
+
+    auto el = m_pool.find(sess);
+    assert(el != m_pool.end());
+
+    if (valid)
     {
-      // Note: removed session is not active and does not need calling
-      // of the cleanup handler.
-      it = m_pool.erase(it);
+      el->second.m_in_reset = false;
+      el->second.m_checked = system_clock::now();
+      idle_insert(el);
     }
     else
+      m_pool.erase(el);
+  }
+
+  // Either a session is ready or there is room for a new one.
+
+  m_release_cond.notify_one();
+}
+
+
+bool Session_pool::add_min_session()
+{
+  {
+    lock_guard guard(m_pool_mutex);
+
+    if (m_pool_closed || m_pool.size() + m_pending >= m_min)
+      return false;
+
+    ++m_pending;
+  }
+
+  std::shared_ptr<cdk::Session> sess;
+
+  try {
+    sess.reset(new cdk::Session(m_ds));
+  }
+  catch (...)
+  {
+    lock_guard guard(m_pool_mutex);
+    --m_pending;
+    throw;
+  }
+
+  {
+    lock_guard guard(m_pool_mutex);
+    --m_pending;
+
+    if (m_pool_closed)
     {
-      ++it;
+      close_session(sess);
+      return false;
     }
+
+    time_point now = system_clock::now();
+    auto el = m_pool.emplace(sess,
+      Sess_data{ deadline_after(m_time_to_live), nullptr, false, now }
+    ).first;
+    idle_insert(el);
   }
+
+  m_release_cond.notify_one();
+  return true;
+}
+
+
+void Session_pool::idle_insert(Pool_iterator el)
+{
+  m_idle.emplace(el->second.m_deadline, el);
+  m_idle_checked.emplace(el->second.m_checked, el);
+}
+
+
+void Session_pool::idle_erase(Pool_iterator el)
+{
+  // Note: normally there is only one entry with given key.
+
+  auto erase_from = [el](Idle_index &index, time_point key)
+  {
+    auto range = index.equal_range(key);
+    for (auto it = range.first; it != range.second; ++it)
+      if (it->second == el)
+      {
+        index.erase(it);
+        return;
+      }
+    assert(false);
+  };
+
+  erase_from(m_idle, el->second.m_deadline);
+  erase_from(m_idle_checked, el->second.m_checked);
 }
 
 
 void Session_pool::set_pool_opts(Settings_impl &opts)
 {
+  if (opts.has_option(Settings_impl::Session_option_impl::FETCH_SIZE))
+    m_fetch_size = opts.get(Settings_impl::Session_option_impl::FETCH_SIZE)
+                   .get_uint();
+  if (opts.has_option(Settings_impl::Session_option_impl::SERVER_CURSOR))
+    m_server_cursor =
+      opts.get(Settings_impl::Session_option_impl::SERVER_CURSOR).get_bool();
+
   if (opts.has_option(Settings_impl::Client_option_impl::POOLING))
   try{
     set_pooling(opts.get(Settings_impl::Client_option_impl::POOLING).get_bool());
@@ -914,4 +1523,22 @@ void Session_pool::set_pool_opts(Settings_impl &opts)
   {
     throw_error("Invalid POOL_MAX_IDLE_TIME value");
   }
+
+
+  if (opts.has_option(Settings_impl::Client_option_impl::POOL_MIN_SIZE))
+  try{
+    set_min_size(
+          static_cast<size_t>(
+            opts.get(Settings_impl::Client_option_impl::POOL_MIN_SIZE)
+            .get_uint()));
+  }catch(...)
+  {
+    throw_error("Invalid POOL_MIN_SIZE value");
+  }
+
+  if (m_min > m_max)
+    throw_error("POOL_MIN_SIZE can not be greater than POOL_MAX_SIZE");
+
+  if (m_pool_enable)
+    start_maintenance();
 }
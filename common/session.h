@@ -36,13 +36,20 @@
 */
 
 #include "common.h"
+#include "expr_cache.h"
 
 #include <mysql/cdk.h>
 
 PUSH_SYS_WARNINGS
+#include <vector>
 #include <list>
+#include <deque>
+#include <algorithm>
+#include <map>
 #include <mutex>
 #include <condition_variable>
+#include <thread>
+#include <atomic>
 POP_SYS_WARNINGS
 
 namespace mysqlx {
@@ -124,6 +131,7 @@ using impl::common::duration;
 using impl::common::time_point;
 using impl::common::Pooled_session;
 using impl::common::Session_cleanup;
+using impl::common::Expr_cache;
 
 
 /*
@@ -154,6 +162,11 @@ public:
     m_max = sz;
   }
 
+  void set_min_size(size_t sz)
+  {
+    m_min = sz;
+  }
+
   void set_timeout(uint64_t ms)
   {
     if (!check_num_limits<int64_t>(ms))
@@ -168,6 +181,20 @@ public:
     m_time_to_live = duration(static_cast<int64_t>(ms));
   }
 
+  // Fetch size used by sessions obtained from this pool.
+
+  row_count_t get_fetch_size() const
+  {
+    return m_fetch_size;
+  }
+
+  // Whether sessions obtained from this pool use server-side cursors.
+
+  bool get_server_cursor() const
+  {
+    return m_server_cursor;
+  }
+
 
 protected:
 
@@ -177,29 +204,128 @@ protected:
     Returns Session if possible (available). Throws error if the pool is closed.
     If cleanup handler is given, it will be called in case this session needs
     to be closed while in use (for example, when pool is closed).
+
+    Sessions from m_idle, already reset by the maintenance thread, are given
+    away without contacting the server. Only if there are none, a released
+    session is reset here or a new one is created.
+
+    Note: Resetting an idle session and creating a new one are done without
+    holding m_pool_mutex, so that other threads can get sessions from the pool
+    in the meantime. A session being reset is kept in m_pool (with m_in_reset
+    flag set) and a session being created is accounted for in m_pending, so
+    that the pool size limit is respected.
   */
 
   std::shared_ptr<cdk::Session> get_session(Session_cleanup* = nullptr);
 
-  void time_to_live_cleanup();
+  struct Sess_data {
+    time_point m_deadline;
+    Session_cleanup *m_cleanup; 
+    bool m_in_reset;
+    time_point m_checked;  // when the session was last reset or checked
+  };
+
+  using Pool = std::map<cdk::shared_ptr<cdk::Session>, Sess_data>;
+  using Pool_iterator = Pool::iterator;
+  using Session_list = std::vector<std::shared_ptr<cdk::Session>>;
+
+  /*
+    Remove idle sessions whose time to live has passed. Removed sessions are
+    moved to the given list so that the caller can close them after
+    releasing the pool lock.
+  */
+
+  void time_to_live_cleanup(Session_list &expired);
+
+  /*
+    Move sessions from m_busy that are no longer referenced outside the pool
+    to m_released. Must be called with m_pool_mutex held.
+  */
+
+  void release_busy();
+
+  /*
+    Background maintenance of the pool, done by a thread started when
+    pooling is configured. The thread resets sessions returned to the pool,
+    so that get_session() can give them away without any round-trips,
+    checks (without resetting them) that idle sessions are still alive
+    and creates new ones to keep
+    at least m_min sessions in the pool. It is woken up when a session is
+    released and otherwise runs every c_maint_interval.
+  */
+
+  void start_maintenance();
+  void stop_maintenance();
+  void maintenance();
+
+  bool reset_released();
+  bool check_idle();
+  bool add_min_session();
+  void return_idle(std::shared_ptr<cdk::Session>&, bool valid);
+
+  /*
+    Add/remove a session to/from both m_idle and m_idle_checked indexes.
+    Both operations take logarithmic time.
+  */
+
+  void idle_insert(Pool_iterator);
+  void idle_erase(Pool_iterator);
 
   cdk::ds::Multi_source m_ds;
   bool m_pool_enable = true;
   bool m_pool_closed = false;
   size_t m_max = 25;
+  size_t m_min = 0;
   duration m_timeout = duration::max();
   duration m_time_to_live = duration::max();
+  row_count_t m_fetch_size = 0;
+  bool m_server_cursor = false;
 
-  struct Sess_data {
-    time_point m_deadline;
-    Session_cleanup *m_cleanup; 
-  };
+  Pool m_pool;
+
+  /*
+    Sessions from m_pool which are not in use and are ready to be given away,
+    indexed by their deadlines. The pool gives away the session with the
+    latest deadline (the last one in the index) and expires sessions from
+    the beginning of the index. The same sessions are also indexed by the
+    time they were last checked in m_idle_checked, so that the maintenance
+    thread finds the one to be checked next without scanning.
+  */
+
+  using Idle_index = std::multimap<time_point, Pool_iterator>;
+
+  Idle_index m_idle;
+  Idle_index m_idle_checked;
+
+  /*
+    Sessions returned to the pool which were not reset yet, the most recently
+    released one first. They are reset by the maintenance thread or, if there
+    are no sessions in m_idle, by get_session().
+  */
+
+  std::list<Pool_iterator> m_released;
 
-  std::map<cdk::shared_ptr<cdk::Session>, Sess_data> m_pool;
+  /*
+    Sessions returned to the pool which are still referenced elsewhere (for
+    example by a result that was not destroyed yet). They are moved to
+    m_released by release_busy() once the pool holds the only reference.
+  */
+
+  std::list<Pool_iterator> m_busy;
+
+  // Number of new sessions that are being created for this pool.
+
+  size_t m_pending = 0;
   std::recursive_mutex m_pool_mutex;
   std::mutex m_reelase_mutex;
   std::condition_variable m_release_cond;
 
+  std::thread m_maint_thread;
+  std::mutex m_maint_mutex;
+  std::condition_variable m_maint_cond;
+  std::atomic<bool> m_maint_stop{false};
+  bool m_maint_wakeup = false;
+
 
   friend Pooled_session;
 };
@@ -221,6 +347,7 @@ class Session_impl
 public:
 
   using string = cdk::string;
+  using Shared_stmt_id = std::shared_ptr<uint32_t>;
 
   Pooled_session      m_sess;
   string              m_default_db;
@@ -228,8 +355,32 @@ public:
   std::set<uint32_t>  m_stmt_id_cleanup;
   size_t              m_max_pstmt = std::numeric_limits<size_t>::max();
 
+  /*
+    Number of rows fetched in one batch when reading results (the FETCH_SIZE
+    option). Value 0 means that the batch size is adjusted automatically.
+  */
+
+  row_count_t         m_fetch_size = 0;
+
+  /*
+    If true, rows of find/select results are streamed from server-side
+    cursors (the SERVER_CURSOR option).
+  */
+
+  bool                m_server_cursor = false;
+
+  /*
+    Expressions used by CRUD operations of this session (selection criteria,
+    sorting and grouping expressions etc.) are parsed once and then taken
+    from this cache when the same expression is used again.
+  */
+
+  Expr_cache          m_expr_cache;
+
   Session_impl(Session_pool_shared &pool)
     : m_sess(pool, this)
+    , m_fetch_size(pool->get_fetch_size())
+    , m_server_cursor(pool->get_server_cursor())
   {
     m_sess.wait();
     if (m_sess->get_default_schema())
@@ -261,6 +412,9 @@ public:
     */
     assert(!m_current_result);
 
+    for (auto &sent : m_sent_ops)
+      delete sent.m_reply;
+
     // TODO: rollback an on-going transaction, if any?
   }
 
@@ -281,15 +435,147 @@ public:
   {
     if (result == m_current_result)
       m_current_result = nullptr;
+    m_cursor_results.erase(result);
+  }
+
+  /*
+    Results whose rows are streamed from a server-side cursor which is
+    suspended. Such result does not block sending other commands. It is
+    removed from this set and becomes the current result again, when it
+    needs to fetch more rows.
+  */
+
+  std::set<Result_impl*> m_cursor_results;
+
+  void suspend_result(Result_impl *result)
+  {
+    deregister_result(result);
+    m_cursor_results.insert(result);
+  }
+
+  void resume_result(Result_impl *result)
+  {
+    if (result == m_current_result)
+      return;
+    prepare_for_cmd();
+    m_cursor_results.erase(result);
+    m_current_result = result;
   }
 
   /*
     Prepare session for sending new command. This caches the current result,
-    if one is registered with session.
+    if one is registered with session, and discards replies of abandoned
+    operations which are next to be read.
   */
 
   void prepare_for_cmd();
 
+  /*
+    Pipelined execution of several operations: after begin_pipeline(),
+    commands sent by Executable_async_if::send() are collected and then written
+    to the server together by send_pipeline(). The operations are then
+    completed with Executable_if::execute() in the order in which they
+    were sent.
+  */
+
+  void begin_pipeline();
+  void send_pipeline();
+
+  /*
+    Operations whose commands were sent by Executable_async_if::send() but
+    whose results were not retrieved by execute() yet, in the order in which
+    they were sent. Server replies to these commands come before replies to
+    any later command. Therefore results of these operations must be
+    retrieved in order and no other command can be executed synchronously
+    before that (see check_sent_op()).
+
+    If such operation is deleted before its results are retrieved, its reply
+    is kept here (with null m_op) until replies to all commands sent before
+    it are read and only then it is discarded (see prepare_for_cmd()).
+  */
+
+  struct Sent_op
+  {
+    const void  *m_op;
+    cdk::Reply  *m_reply;
+  };
+
+  std::deque<Sent_op> m_sent_ops;
+
+  std::deque<Sent_op>::iterator find_sent_op(const void *op)
+  {
+    return std::find_if(m_sent_ops.begin(), m_sent_ops.end(),
+      [op](const Sent_op &sent) { return sent.m_op == op; }
+    );
+  }
+
+  void op_sent(const void *op)
+  {
+    m_sent_ops.push_back({ op, nullptr });
+  }
+
+  void op_done(const void *op)
+  {
+    auto it = find_sent_op(op);
+    if (it != m_sent_ops.end())
+      m_sent_ops.erase(it);
+  }
+
+  /*
+    Called when operation is deleted. Returns true if the session takes
+    ownership of its reply, which is then discarded later.
+  */
+
+  bool op_abandoned(const void *op, cdk::Reply *reply)
+  {
+    auto it = find_sent_op(op);
+    if (it == m_sent_ops.end())
+      return false;
+
+    if (!reply)
+    {
+      m_sent_ops.erase(it);
+      return false;
+    }
+
+    it->m_op = nullptr;
+    it->m_reply = reply;
+    return true;
+  }
+
+  /*
+    Check if results of the given sent operation, or of a new command if op
+    is null, can be retrieved now. Throws error otherwise.
+  */
+
+  void check_sent_op(const void *op)
+  {
+    if (m_sent_ops.empty() || op == m_sent_ops.front().m_op)
+      return;
+
+    if (op)
+      common::throw_error("Results of asynchronous operations of a session must be"
+                  " retrieved in the order in which they were started");
+
+    common::throw_error("Can not execute a statement before results of pending"
+                " asynchronous operations of the same session are retrieved");
+  }
+
+  /*
+    Event loop integration: the session socket can be watched for the I/O
+    reported by wants_read() and wants_write(), in which case progress()
+    drives pending operations without blocking.
+  */
+
+  unsigned get_fd();
+  bool wants_read();
+  bool wants_write();
+  void progress();
+
+  // Set session parameters (such as m_fetch_size) from given settings.
+
+  void set_options(Settings_impl&);
+
   unsigned long m_savepoint = 0;
 
   unsigned long next_savepoint()
@@ -359,6 +645,57 @@ public:
     m_max_pstmt = m_stmt_id.size();
   }
 
+  /*
+    Session-wide cache of prepared statements.
+
+    Statements are identified by a key which describes their shape (see
+    Op_base::get_stmt_key()). Different statement objects with the same key
+    can execute the same server-side prepared statement. The cache keeps
+    up to `c_stmt_cache_size` most recently used keys. A key can be present
+    without statement id, which means that a statement with this shape was
+    executed once but was not prepared yet.
+
+    Statement ids are shared with the operations that use them. When an entry
+    is evicted and no operation uses its id anymore, the id is released and
+    the prepared statement gets deallocated (see clean_up_stmt_id()).
+  */
+
+  static const size_t c_stmt_cache_size = 64;
+
+  struct Stmt_entry
+  {
+    std::string     m_key;
+    Shared_stmt_id  m_id;
+  };
+
+  using Stmt_list = std::list<Stmt_entry>;
+
+  Stmt_list  m_stmt_cache;
+  std::map<std::string, Stmt_list::iterator> m_stmt_cache_map;
+
+  /*
+    Look up statement with the given key. Returns false if a statement with
+    this key was not seen before -- it is then added to the cache. Otherwise
+    returns true and sets `id` to the id of the prepared statement or to null
+    if statement was not yet prepared.
+  */
+
+  bool find_stmt(const std::string &key, Shared_stmt_id &id);
+
+  // Store id of the statement prepared for the given key.
+
+  void cache_stmt(const std::string &key, const Shared_stmt_id &id);
+
+  // Remove given statement id from the cache (after failed prepare).
+
+  void uncache_stmt(const Shared_stmt_id &id);
+
+private:
+
+  void stmt_cache_insert(const std::string &key, const Shared_stmt_id &id);
+
+public:
+
   /*
     Send commands to server to deallocate PS ids that are no longer in use.
   */
@@ -384,6 +721,14 @@ public:
   void cleanup() override
   {
     prepare_for_cmd();
+
+    // Store remaining rows of results which use server-side cursors.
+
+    while (!m_cursor_results.empty())
+    {
+      resume_result(*m_cursor_results.begin());
+      prepare_for_cmd();
+    }
   }
 };
 
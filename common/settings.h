@@ -313,6 +313,11 @@ private:
       m_data.m_tls_vers = true;
       break;
 
+    case Session_option_impl::COMPRESSION_ALGORITHMS:
+      m_multi = !m_data.m_compr_algs;
+      m_data.m_compr_algs = true;
+      break;
+
     default:
       {
         std::stringstream err_msg;
@@ -521,6 +526,8 @@ private:
         return m_setter.key_val(Client_option_impl::POOL_QUEUE_TIMEOUT);
       else if (upper_key == "MAXIDLETIME")
         return m_setter.key_val(Client_option_impl::POOL_MAX_IDLE_TIME);
+      else if (upper_key == "MINSIZE")
+        return m_setter.key_val(Client_option_impl::POOL_MIN_SIZE);
 
       std::string msg = "Invalid pooling option: " + key;
       throw_error(msg.c_str());
@@ -850,6 +857,50 @@ Settings_impl::Setter::set_option<Settings_impl::Session_option_impl::AUTH>(
 }
 
 
+// Compression options.
+
+template<>
+inline void
+Settings_impl::Setter::set_option<Settings_impl::Session_option_impl::COMPRESSION>(
+  const unsigned &val
+)
+{
+  if (0 == val || val >= size_t(Compression_mode::LAST))
+    throw_error("Invalid COMPRESSION value");
+  add_option(Session_option_impl::COMPRESSION, val);
+}
+
+
+template<>
+inline void
+Settings_impl::Setter::set_option<Settings_impl::Session_option_impl::COMPRESSION>(
+  const std::string &val
+)
+{
+  using std::map;
+
+#define COMPRESSION_MAP(X,N) { #X, Compression_mode::X },
+
+  static map< std::string, Compression_mode > compression_map{
+    COMPRESSION_MODE_LIST(COMPRESSION_MAP)
+  };
+
+  try {
+
+    Compression_mode m = compression_map.at(to_upper(val));
+    set_option<Session_option_impl::COMPRESSION>(unsigned(m));
+    return;
+  }
+  catch (const std::out_of_range&)
+  {
+    std::string msg = "Invalid compression mode: " + val;
+    throw_error(msg.c_str());
+    // Quiet compiler warnings
+    return;
+  }
+}
+
+
 // Connection attributes.
 
 
@@ -1031,6 +1082,23 @@ Settings_impl::Setter::set_option<
     add_option((int)Settings_impl::Session_option_impl::TLS_VERSIONS, val);
 }
 
+template<>
+inline void
+Settings_impl::Setter::set_option<
+  Settings_impl::Session_option_impl::COMPRESSION_ALGORITHMS
+>(const std::string &val)
+{
+  m_data.m_compr_algs = true;  // record that the option was set
+
+  // If in multi mode, the value is a single list element, otherwise
+  // the value can be a comma separated list
+
+  if (!m_multi)
+    set_comma_separated((int)Settings_impl::Session_option_impl::COMPRESSION_ALGORITHMS, val);
+  else
+    add_option((int)Settings_impl::Session_option_impl::COMPRESSION_ALGORITHMS, val);
+}
+
 
 // Generic add_option() method.
 
@@ -1053,6 +1121,7 @@ void Settings_impl::Setter::add_option(int opt, const T &val)
 
   case Session_option_impl::TLS_CIPHERSUITES:
   case Session_option_impl::TLS_VERSIONS:
+  case Session_option_impl::COMPRESSION_ALGORITHMS:
     if (m_multi)
     {
       options.emplace_back(opt, val);
@@ -1113,6 +1182,19 @@ void Settings_impl::Setter::str(const string &val)
     return x;
   };
 
+  // Boolean options accept "true"/"false" as well as numeric values.
+
+  auto to_bool = [&]() -> bool
+  {
+    std::string tmp = to_lower(utf8_val);
+
+    if ("true" == tmp)
+      return true;
+    if ("false" == tmp)
+      return false;
+    return 0 != to_number();
+  };
+
 #define SET_OPTION_STR_str(X,N) \
   case Session_option_impl::X: return set_option<Session_option_impl::X,std::string>(utf8_val);
 #define SET_OPTION_STR_any(X,N) SET_OPTION_STR_str(X,N)
@@ -1127,7 +1209,16 @@ void Settings_impl::Setter::str(const string &val)
     throw_error("Can not convert to integer value"); \
   }
 
-  #define SET_OPTION_STR_bool(X,N) SET_OPTION_STR_num(X,N)
+#define SET_OPTION_STR_bool(X,N) \
+  case Session_option_impl::X: \
+  try \
+  { \
+    return set_option<Session_option_impl::X,bool>(to_bool()); \
+  } \
+  catch (const std::invalid_argument&) \
+  { \
+    throw_error("Can not convert to Boolean value"); \
+  }
 
   switch (m_cur_opt)
   {
@@ -1381,6 +1472,7 @@ void Settings_impl::Setter::key_val(const std::string &key,
 
       case Settings_impl::Session_option_impl::TLS_CIPHERSUITES:
       case Settings_impl::Session_option_impl::TLS_VERSIONS:
+      case Settings_impl::Session_option_impl::COMPRESSION_ALGORITHMS:
         {
           auto *prc = key_val(option)->arr();
           if (!prc)
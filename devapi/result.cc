@@ -451,11 +451,33 @@ mysqlx::col_count_t Row_detail::col_count() const
 
 mysqlx::bytes Row_detail::get_bytes(mysqlx::col_count_t pos) const
 {
-  cdk::bytes data = get_impl().m_data.at(pos).data();
+  cdk::bytes data = get_impl().m_data.at(pos);
   return mysqlx::bytes::Access::mk(data);
 }
 
 
+mysqlx::bytes Row_detail::get_utf8(mysqlx::col_count_t pos) const
+{
+  cdk::bytes data = get_impl().get_utf8(pos);
+  return mysqlx::bytes::Access::mk(data);
+}
+
+
+bool Row_detail::get_decimal(mysqlx::col_count_t pos, mysqlx::Decimal &val) const
+{
+  cdk::Decimal dec;
+
+  if (!get_impl().get_decimal(pos, dec))
+    return false;
+
+  val.negative = dec.negative;
+  val.scale = dec.scale;
+  val.digit_count = dec.digit_count;
+  std::copy(dec.digits, dec.digits + dec.digit_count, val.digits);
+  return true;
+}
+
+
 mysqlx::Value& Row_detail::get_val(mysqlx::col_count_t pos)
 {
   return get_impl().get(pos);
@@ -691,7 +713,7 @@ bool Doc_result_detail::iterator_next()
     return false;
 
   // @todo Avoid copying of document string.
-  cdk::foundation::bytes data = row->at(0).data();
+  cdk::foundation::bytes data = row->at(0);
   m_cur_doc = DbDoc(std::string(data.begin(),data.end()-1));
   return true;
 }
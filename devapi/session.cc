@@ -244,6 +244,7 @@ Session_detail::Session_detail(common::Settings_impl &settings)
     cdk::ds::Multi_source source;
     settings.get_data_source(source);
     m_impl = std::make_shared<Impl>(source);
+    m_impl->set_options(settings);
 
   }
   catch (const cdk::foundation::connection::TLS::Options::TLS_version::Error &e)
@@ -293,6 +294,42 @@ void Session_detail::prepare_for_cmd()
 }
 
 
+void Session_detail::begin_pipeline()
+{
+  get_impl().begin_pipeline();
+}
+
+
+void Session_detail::send_pipeline()
+{
+  get_impl().send_pipeline();
+}
+
+
+unsigned Session_detail::get_fd()
+{
+  return get_impl().get_fd();
+}
+
+
+bool Session_detail::wants_read()
+{
+  return get_impl().wants_read();
+}
+
+
+bool Session_detail::wants_write()
+{
+  return get_impl().wants_write();
+}
+
+
+void Session_detail::progress()
+{
+  get_impl().progress();
+}
+
+
 void Session_detail::close()
 {
   m_impl->release();
@@ -462,7 +499,7 @@ Schema_detail::Table_src::iterator_get()
 
   cdk::string type;
   m_res->get_column(1).get<cdk::TYPE_STRING>()
-    .m_codec.from_bytes(row->at(1).data(), type);
+    .m_codec.from_bytes(row->at(1), type);
 
   return Table(m_schema, Name_src::iterator_get(), type == "VIEW");
 }
@@ -488,7 +525,7 @@ mysqlx::string Query_src::iterator_get()
   auto *row = static_cast<const Row_data*>(m_row);
 
   const auto &name_col = m_res->get_column(0);
-  const auto &data = row->at(0).data();
+  const auto data = row->at(0);
   cdk::string name;
 
   // TDOD: Investigate why we get column type other than STRING.
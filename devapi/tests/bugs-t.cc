@@ -482,7 +482,12 @@ TEST_F(Bugs, crud_move)
               sql("select count(*) from performance_schema.prepared_statements_instances").fetchOne()[0].get<int>());
   }
 
-  //Force stmt_id cleanup
+  /*
+    Note: Prepared statements are kept in session-wide cache (keyed by statement
+    shape) after statement objects that prepared them are modified or
+    destroyed. Each new shape adds one prepared statement.
+  */
+
   find.sort("name ASC");
   find.execute();
   find.execute();
@@ -503,7 +508,7 @@ TEST_F(Bugs, crud_move)
     find2.execute();
     find2.execute();
 
-    EXPECT_EQ(1,
+    EXPECT_EQ(3,
               sql("select count(*) from performance_schema.prepared_statements_instances").fetchOne()[0].get<int>());
 
     //Move works just like assignment (same as shared_ptr behaviour)
@@ -521,26 +526,25 @@ TEST_F(Bugs, crud_move)
       find3.execute();
       find3.execute();
 
-      EXPECT_EQ(1,
+      EXPECT_EQ(3,
                 sql("select count(*) from performance_schema.prepared_statements_instances").fetchOne()[0].get<int>());
 
       find.sort("name ASC");
 
-      // query
+      // execute prepared (statement with this shape was prepared before)
       find.execute();
-      // prepare+execute
       find.execute();
       // execute
       find2.execute();
       // execute
       find3.execute();
 
-      EXPECT_EQ(2,
+      EXPECT_EQ(3,
                 sql("select count(*) from performance_schema.prepared_statements_instances").fetchOne()[0].get<int>());
 
     } //find3 scope
 
-    EXPECT_EQ(2,
+    EXPECT_EQ(3,
               sql("select count(*) from performance_schema.prepared_statements_instances").fetchOne()[0].get<int>());
 
   }// find2 scope
@@ -550,7 +554,7 @@ TEST_F(Bugs, crud_move)
   find.execute();
   find.execute();
 
-  EXPECT_EQ(1,
+  EXPECT_EQ(4,
             sql("select count(*) from performance_schema.prepared_statements_instances").fetchOne()[0].get<int>());
 
 
@@ -1927,6 +1927,54 @@ TEST_F(Crud, add_empty)
 }
 
 
+TEST_F(Crud, add_chunked)
+{
+  SKIP_IF_NO_XPLUGIN;
+
+  Schema sch = getSchema("test");
+  Collection coll = sch.createCollection("c1", true);
+
+  coll.remove("true").execute();
+
+  /*
+    Documents added with addAll() of total size above the chunk size limit
+    are sent in several chunks. Check that affected rows and generated ids
+    are reported for all of them.
+  */
+
+  std::string payload(1024*1024, 'x');
+  std::vector<std::string> docs;
+
+  for (unsigned i = 0; i < 40; ++i)
+  {
+    docs.push_back(
+      "{\"n\": " + std::to_string(i) + ", \"data\": \"" + payload + "\"}"
+    );
+  }
+
+  Result res = CollectionAdd(coll).addAll(docs.begin(), docs.end()).execute();
+  std::vector<std::string> ids = res.getGeneratedIds();
+  EXPECT_EQ(40U, res.getAffectedItemsCount());
+  EXPECT_EQ(40U, ids.size());
+  EXPECT_EQ(40U, coll.count());
+
+  // Documents from a range are read only when executing the operation.
+
+  std::vector<DbDoc> more;
+  for (unsigned i = 40; i < 60; ++i)
+    more.emplace_back("{\"n\": " + std::to_string(i) + "}");
+
+  CollectionAdd add = coll.add("{\"n\": 100}").addAll(more.begin(), more.end());
+  more.back() = DbDoc("{\"n\": 60}");
+
+  res = add.execute();
+  ids = res.getGeneratedIds();
+  EXPECT_EQ(21U, res.getAffectedItemsCount());
+  EXPECT_EQ(21U, ids.size());
+  EXPECT_EQ(61U, coll.count());
+}
+
+
 TEST_F(Crud, group_by_having)
 {
   SKIP_IF_NO_XPLUGIN;
@@ -2175,6 +2223,144 @@ TEST_F(Crud, multi_statment_exec)
 }
 
 
+TEST_F(Crud, pipeline)
+{
+  SKIP_IF_NO_XPLUGIN;
+
+  Schema sch = getSchema("test");
+  Collection coll = sch.createCollection("c1", true);
+
+  add_data(coll);
+
+  /*
+    Results of pipelined operations, including ones with row data, are
+    returned in order.
+  */
+
+  auto find = coll.find("age = :age");
+
+  auto res = get_sess().pipeline(
+    find.bind("age", 2),
+    coll.add("{\"name\": \"pipe\", \"age\": 7}"),
+    coll.modify("name = 'pipe'").set("age", 8),
+    get_sess().sql("SELECT 1, 2"),
+    coll.find("name = 'pipe'")
+  );
+
+  EXPECT_EQ(2, std::get<0>(res).fetchOne()["age"].get<int>());
+  EXPECT_EQ(1U, std::get<1>(res).getAffectedItemsCount());
+  EXPECT_EQ(1U, std::get<2>(res).getAffectedItemsCount());
+
+  Row row = std::get<3>(res).fetchOne();
+  EXPECT_EQ(2, row[1].get<int>());
+
+  DbDoc doc = std::get<4>(res).fetchOne();
+  EXPECT_EQ(8, doc["age"].get<int>());
+
+  // Error in one operation does not prevent execution of the following ones.
+
+  EXPECT_THROW(
+    get_sess().pipeline(
+      get_sess().sql("SELECT * FROM no_such_table"),
+      coll.remove("name = 'pipe'")
+    ),
+    Error
+  );
+
+  EXPECT_EQ(0U, coll.find("name = 'pipe'").execute().count());
+}
+
+
+TEST_F(Crud, execute_async)
+{
+  SKIP_IF_NO_XPLUGIN;
+
+  Schema sch = getSchema("test");
+  Collection coll = sch.createCollection("c1", true);
+
+  add_data(coll);
+
+  mysqlx::Session sess2(get_uri());
+
+  // Drive operations of two sessions from a single thread.
+
+  auto find = coll.find("age = :age").bind("age", 2);
+  AsyncResult<DocResult> find_res = find.executeAsync();
+  AsyncResult<SqlResult> sleep_res = sess2.sql("SELECT SLEEP(1), 7").executeAsync();
+
+  /*
+    The operation can be changed and started again in the meantime, but
+    it can not be executed synchronously before pending results of its
+    session are retrieved.
+  */
+
+  AsyncResult<DocResult> find_res2 = find.bind("age", 3).executeAsync();
+  EXPECT_THROW(find.execute(), Error);
+
+  while (!find_res.isReady() || !sleep_res.isReady())
+    std::this_thread::yield();
+
+  EXPECT_EQ(2, find_res.get().fetchOne()["age"].get<int>());
+  EXPECT_FALSE(find_res.isValid());
+  EXPECT_THROW(find_res.get(), Error);
+
+  EXPECT_EQ(1U, find_res2.get().count());
+  EXPECT_EQ(1U, find.execute().count());
+
+  EXPECT_EQ(7, sleep_res.get().fetchOne()[1].get<int>());
+
+  // Results of operations of the same session are retrieved in order.
+
+  auto add_res = coll.add("{\"name\": \"async\"}").executeAsync();
+  auto count_res = get_sess().sql("SELECT COUNT(*) FROM test.c1").executeAsync();
+
+  EXPECT_EQ(1U, add_res.get().getAffectedItemsCount());
+  EXPECT_EQ(7, count_res.get().fetchOne()[0].get<int>());
+
+  // Retrieving results out of order is an error.
+
+  auto sel_res = get_sess().sql("SELECT 1").executeAsync();
+  auto sel_res2 = get_sess().sql("SELECT 2").executeAsync();
+
+  EXPECT_THROW(sel_res2.get(), Error);
+  EXPECT_EQ(1, sel_res.get().fetchOne()[0].get<int>());
+
+  // Server errors are reported by get().
+
+  auto err_res = get_sess().sql("SELECT * FROM no_such_table").executeAsync();
+
+  while (!err_res.isReady())
+    std::this_thread::yield();
+
+  EXPECT_THROW(err_res.get(), Error);
+  EXPECT_EQ(1U, get_sess().sql("SELECT 1").execute().count());
+}
+
+
+TEST_F(Crud, event_loop)
+{
+  SKIP_IF_NO_XPLUGIN;
+
+  mysqlx::Session &sess = get_sess();
+
+  auto res = sess.sql("SELECT SLEEP(1), 7").executeAsync();
+
+  // Command is sent and the session waits for the reply.
+
+  sess.progress();
+  EXPECT_TRUE(sess.wantsRead());
+  EXPECT_FALSE(sess.wantsWrite());
+
+  while (!res.isReady())
+  {
+    sess.progress();
+    std::this_thread::yield();
+  }
+
+  EXPECT_EQ(7, res.get().fetchOne()[1].get<int>());
+}
+
+
 TEST_F(Crud, expr_in_expr)
 {
   SKIP_IF_NO_XPLUGIN;
@@ -2744,9 +2930,15 @@ TEST_F(Crud, PS)
     cpy_find(finds2);
     cpy_find(finds3);
 
+    /*
+      Statements with the same shape share prepared statement from the session
+      cache: one for the plain find and one for the find with limits. In the
+      second round the sorted find prepared in the first round is also cached.
+    */
+
+    int cached = (i == 0 ? 2 : 3);
 
-    //Only 100, because the PS id is shared by finds finds2 and finds3
-    EXPECT_EQ(100,
+    EXPECT_EQ(cached,
               sql("select count(*) from performance_schema.prepared_statements_instances").fetchOne()[0].get<int>());
 
     //Since no re-prepare needed, all use same PS id
@@ -2756,18 +2948,16 @@ TEST_F(Crud, PS)
     execute_find(finds2,-1, -1, 6, false);
     execute_find(finds3,-1, -1, 6, false);
 
-    //Only 100, because the PS id is shared by finds finds2 and finds3
-    EXPECT_EQ(100,
+    EXPECT_EQ(cached,
               sql("select count(*) from performance_schema.prepared_statements_instances").fetchOne()[0].get<int>());
 
 
-    //Prepare+Execute
+    //ExecutePrepared (find with limits was prepared before)
     execute_find(finds,-1, 5, 1, false);
     execute_find(finds2,-1, 5, 1, false);
     execute_find(finds3,-1, 5, 1, false);
 
-    //Reaches max PS because sort forces a re-prepare
-    EXPECT_EQ(199,
+    EXPECT_EQ(cached,
               sql("select count(*) from performance_schema.prepared_statements_instances").fetchOne()[0].get<int>());
 
     //ExecutePrepared
@@ -2787,8 +2977,7 @@ TEST_F(Crud, PS)
     execute_find(finds3,1, 1, 1, false);
 
     //SET SORT
-    //Re-prepare needed, so find3 will only deirect execute because it passed
-    //max_prepared_stmt_count = 200
+    //New statement shape: prepared once and then shared by all finds
 
     //Execute
     execute_find_sort(finds,true, 1);
@@ -2798,15 +2987,13 @@ TEST_F(Crud, PS)
     //Prepare+Execute
     execute_find_sort(finds,false, 1);
 
-    //After release, finds take first 100 PS ids
-    EXPECT_EQ(100,
+    EXPECT_EQ(3,
               sql("select count(*) from performance_schema.prepared_statements_instances").fetchOne()[0].get<int>());
 
     execute_find_sort(finds2,false, 1);
     execute_find_sort(finds3,false, 1);
 
-    //Reaches max PS, since finds no longer share ids.
-    EXPECT_EQ(199,
+    EXPECT_EQ(3,
               sql("select count(*) from performance_schema.prepared_statements_instances").fetchOne()[0].get<int>());
 
 
@@ -2854,6 +3041,37 @@ TEST_F(Crud, PS)
     modify.execute();
   }
 
+  /*
+    Exhaust both the session cache of prepared statements (64 entries) and
+    the server limit on prepared statements: execute many more distinct
+    statement shapes than the cache can hold, each one twice so that it gets
+    prepared. Statements that can not be prepared are directly executed and
+    the number of prepared statements stays within the limit.
+  */
+
+  sql("set global max_prepared_stmt_count=16;");
+
+  for (int i = 0; i < 200; ++i)
+  {
+    std::string crit = "name like :name and age < :age and "
+                       + std::to_string(i) + " = " + std::to_string(i);
+
+    //Execute
+    EXPECT_EQ(6, coll.find(crit).bind("name", "%").bind("age", 1000)
+                     .execute().count());
+    //Prepare+Execute
+    EXPECT_EQ(6, coll.find(crit).bind("name", "%").bind("age", 1000)
+                     .execute().count());
+  }
+
+  int ps_count
+    = sql("select count(*) from performance_schema.prepared_statements_instances")
+      .fetchOne()[0].get<int>();
+
+  EXPECT_LT(0, ps_count);
+  EXPECT_GE(16, ps_count);
+
+  sql("set global max_prepared_stmt_count=199;");
 }
 
 TEST_F(Crud, overlaps)
@@ -32,6 +32,7 @@
 #include <iostream>
 #include <future>
 #include <chrono>
+#include <thread>
 
 using std::cout;
 using std::endl;
@@ -736,6 +737,237 @@ TEST_F(Sess, timeout_opts)
 }
 
 
+TEST_F(Sess, fetch_size)
+{
+  EXPECT_NO_THROW(
+    SessionSettings settings("root@localhost?fetch-size=100")
+  );
+
+  EXPECT_NO_THROW(
+    SessionSettings settings(SessionOption::FETCH_SIZE, 100)
+  );
+
+  EXPECT_THROW(
+    SessionSettings settings("root@localhost?fetch-size=-1"),
+    Error
+  );
+
+  EXPECT_THROW(
+    SessionSettings settings(SessionOption::FETCH_SIZE, -1),
+    Error
+  );
+
+  SKIP_IF_NO_XPLUGIN;
+  SKIP_IF_SERVER_VERSION_LESS(8, 0, 1);
+
+  /*
+    Read the same rows using different fetch sizes, including automatically
+    adjusted one (0), and check that all of them are returned. Fetch size
+    set for a client is used by sessions from the pool.
+  */
+
+  const char *query =
+    "WITH RECURSIVE seq (n) AS"
+    " (SELECT 1 UNION ALL SELECT n + 1 FROM seq WHERE n < 1000)"
+    " SELECT n, REPEAT('x', n) FROM seq";
+
+  auto check_result = [](SqlResult &&res)
+  {
+    unsigned n = 0;
+    for (Row row : res)
+    {
+      ++n;
+      EXPECT_EQ(n, row[0].get<unsigned>());
+      EXPECT_EQ(n, row[1].get<string>().length());
+    }
+    EXPECT_EQ(1000U, n);
+  };
+
+  auto check_rows = [query, &check_result](mysqlx::Session &sess)
+  {
+    check_result(sess.sql(query).execute());
+  };
+
+  for (unsigned fetch_size : { 0U, 1U, 7U, 1000U })
+  {
+    std::stringstream uri;
+    uri << get_uri() << "/?fetch-size=" << fetch_size;
+
+    mysqlx::Session sess(uri.str());
+    check_rows(sess);
+
+    mysqlx::Client cli(uri.str());
+    mysqlx::Session pooled_sess = cli.getSession();
+    check_rows(pooled_sess);
+  }
+
+  // Fetch size of the session can be overridden for a single statement.
+
+  std::stringstream uri;
+  uri << get_uri() << "/?fetch-size=1000";
+  mysqlx::Session sess(uri.str());
+  SqlStatement stmt = sess.sql(query);
+
+  for (unsigned fetch_size : { 1U, 7U, 0U })
+  {
+    stmt.setFetchSize(fetch_size);
+    check_result(stmt.execute());
+  }
+}
+
+
+TEST_F(Sess, server_cursor)
+{
+  EXPECT_NO_THROW(
+    SessionSettings settings("root@localhost?server-cursor=true")
+  );
+
+  EXPECT_NO_THROW(
+    SessionSettings settings(SessionOption::SERVER_CURSOR, true)
+  );
+
+  EXPECT_THROW(
+    SessionSettings settings("root@localhost?server-cursor=foo"),
+    Error
+  );
+
+  SKIP_IF_NO_XPLUGIN;
+  SKIP_IF_SERVER_VERSION_LESS(8, 0, 16);
+
+  {
+    Collection coll = get_sess().getSchema("test").createCollection("c", true);
+    coll.remove("true").execute();
+    for (unsigned i = 1; i <= 500; ++i)
+      coll.add(DbDoc("{\"n\": " + std::to_string(i) + "}")).execute();
+  }
+
+  /*
+    Read rows from a server-side cursor in small batches, interleaving it
+    with other commands sent to the server and with reading another result.
+    Then leave a partially read result when session is closed.
+  */
+
+  for (unsigned fetch_size : { 0U, 1U, 7U })
+  {
+    std::stringstream uri;
+    uri << get_uri() << "/?server-cursor=true&fetch-size=" << fetch_size;
+
+    mysqlx::Session sess(uri.str());
+    Collection coll = sess.getSchema("test").getCollection("c");
+
+    DocResult res = coll.find().sort("n").execute();
+    DocResult res1 = coll.find("n > 250").sort("n").execute();
+
+    unsigned n = 0;
+    for (DbDoc doc : res)
+    {
+      ++n;
+      EXPECT_EQ(n, doc["n"].get<unsigned>());
+      if (0 == n % 100)
+      {
+        EXPECT_EQ(500U, coll.count());
+        DbDoc doc1 = res1.fetchOne();
+        EXPECT_EQ(250 + n/100, doc1["n"].get<unsigned>());
+      }
+    }
+    EXPECT_EQ(500U, n);
+    EXPECT_EQ(245U, res1.count());
+
+    DocResult res2 = coll.find().execute();
+    EXPECT_TRUE(res2.fetchOne());
+    sess.close();
+    EXPECT_EQ(499U, res2.count());
+  }
+}
+
+
+TEST_F(Sess, compression)
+{
+  EXPECT_NO_THROW(
+    SessionSettings settings("root@localhost?compression=PREFERRED")
+  );
+
+  EXPECT_NO_THROW(
+    SessionSettings settings(
+      "root@localhost?compression=required"
+      "&compression-algorithms=[deflate_stream,foo]"
+    )
+  );
+
+  EXPECT_NO_THROW(
+    SessionSettings settings(
+      SessionOption::COMPRESSION, CompressionMode::DISABLED,
+      SessionOption::COMPRESSION_ALGORITHMS, "deflate_stream,foo"
+    )
+  );
+
+  EXPECT_THROW(
+    SessionSettings settings("root@localhost?compression=foo"),
+    Error
+  );
+
+  EXPECT_THROW(
+    SessionSettings settings(SessionOption::COMPRESSION, "required"),
+    Error
+  );
+
+  EXPECT_THROW(
+    SessionSettings settings(SessionOption::SSL_MODE, CompressionMode::REQUIRED),
+    Error
+  );
+
+  SKIP_IF_NO_XPLUGIN;
+
+  auto check_rows = [](mysqlx::Session &sess)
+  {
+    SqlResult res = sess.sql(
+      "SELECT REPEAT('x', 100000), REPEAT('y', 10)"
+    ).execute();
+
+    Row row = res.fetchOne();
+    EXPECT_EQ(string(100000, 'x'), row[0].get<string>());
+    EXPECT_EQ(string(10, 'y'), row[1].get<string>());
+  };
+
+  // Preferred compression works with any server version.
+
+  {
+    mysqlx::Session sess(get_uri() + "/?compression=preferred");
+    check_rows(sess);
+  }
+
+  {
+    mysqlx::Session sess(
+      get_uri() + "/?compression=preferred&compression-algorithms=[foo]"
+    );
+    check_rows(sess);
+  }
+
+  EXPECT_THROW(
+    mysqlx::Session sess(
+      get_uri() + "/?compression=required&compression-algorithms=[foo]"
+    ),
+    Error
+  );
+
+  SKIP_IF_SERVER_VERSION_LESS(8, 0, 19);
+
+  {
+    mysqlx::Session sess(get_uri() + "/?compression=required");
+    check_rows(sess);
+  }
+
+  {
+    mysqlx::Client cli(
+      get_uri() + "/?compression=required"
+      "&compression-algorithms=[foo,deflate_stream]"
+    );
+    mysqlx::Session sess = cli.getSession();
+    check_rows(sess);
+  }
+}
+
+
 TEST_F(Sess, connect_timeout)
 {
 // Set MANUAL_TESTING to 1 and define NON_BOUNCE_SERVER
@@ -2154,6 +2386,125 @@ TEST_F(Sess, pool_use)
 }
 
 
+TEST_F(Sess, pool_concurrent)
+{
+  SKIP_IF_NO_XPLUGIN;
+  // Session reset keeps the connection only since 8.0.16
+  SKIP_IF_SERVER_VERSION_LESS(8, 0, 16);
+
+  /*
+    Many threads get sessions from a small pool at the same time. New
+    sessions are created and idle ones are reset outside of the pool lock,
+    but the pool must never hold more sessions than POOL_MAX_SIZE.
+  */
+
+  const unsigned max_size = 5;
+  const unsigned threads = 20;
+
+  mysqlx::Client client(
+    get_uri(),
+    ClientOption::POOL_MAX_SIZE, max_size,
+    ClientOption::POOL_QUEUE_TIMEOUT, std::chrono::seconds(60)
+  );
+
+  auto task = [&client]() -> std::set<uint64_t>
+  {
+    std::set<uint64_t> ids;
+    for (int i = 0; i < 5; ++i)
+    {
+      mysqlx::Session sess = client.getSession();
+      ids.insert(
+        sess.sql("SELECT CONNECTION_ID()").execute()
+          .fetchOne()[0].get<uint64_t>()
+      );
+    }
+    return ids;
+  };
+
+  std::vector<std::future<std::set<uint64_t>>> results;
+
+  for (unsigned i = 0; i < threads; ++i)
+    results.push_back(std::async(std::launch::async, task));
+
+  std::set<uint64_t> ids;
+
+  for (auto &res : results)
+  {
+    std::set<uint64_t> part = res.get();
+    ids.insert(part.begin(), part.end());
+  }
+
+  EXPECT_GE(max_size, ids.size());
+}
+
+
+TEST_F(Sess, pool_min_size)
+{
+  SKIP_IF_NO_XPLUGIN;
+  // Session reset keeps the connection only since 8.0.16
+  SKIP_IF_SERVER_VERSION_LESS(8, 0, 16);
+
+  EXPECT_THROW(
+    mysqlx::Client(
+      get_uri(), R"({ "pooling": { "maxSize": 2, "minSize": 3 } })"
+    ),
+    Error
+  );
+
+  /*
+    Sessions created by the pool are marked with a connection attribute so
+    that they can be counted. The pool should open POOL_MIN_SIZE sessions in
+    the background and keep them after POOL_MAX_IDLE_TIME has passed.
+  */
+
+  const int min_size = 3;
+
+  auto count_sessions = [this]() -> int
+  {
+    return sql(
+      "SELECT COUNT(*) FROM performance_schema.session_connect_attrs"
+      " WHERE ATTR_NAME = 'pool_test' AND ATTR_VALUE = 'min_size'"
+    ).fetchOne()[0].get<int>();
+  };
+
+  mysqlx::Client client(
+    get_uri() + "/?connection-attributes=[pool_test=min_size]",
+    ClientOption::POOL_MIN_SIZE, min_size,
+    ClientOption::POOL_MAX_SIZE, 5,
+    ClientOption::POOL_MAX_IDLE_TIME, 100
+  );
+
+  auto wait_for_sessions = [&count_sessions](int expected) -> int
+  {
+    int count = 0;
+    for (int i = 0; i < 50; ++i)
+    {
+      count = count_sessions();
+      if (count == expected)
+        break;
+      std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+    return count;
+  };
+
+  EXPECT_EQ(min_size, wait_for_sessions(min_size));
+
+  // Sessions above the minimum expire, idle ones below it are kept.
+
+  {
+    std::vector<mysqlx::Session> sessions;
+    for (int i = 0; i < 5; ++i)
+      sessions.emplace_back(client.getSession());
+    EXPECT_EQ(5, count_sessions());
+  }
+
+  EXPECT_EQ(min_size, wait_for_sessions(min_size));
+
+  client.close();
+  EXPECT_EQ(0, wait_for_sessions(0));
+}
+
+
 TEST_F(Sess, pool_ttl)
 {
   SKIP_IF_NO_XPLUGIN;
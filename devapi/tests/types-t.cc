@@ -303,6 +303,18 @@ TEST_F(Types, basic)
 
     EXPECT_GT(row[1].getRawBytes().size(), 1);
     EXPECT_EQ(data_string[i].length(), string(row[4]).length());
+
+    // Exact DECIMAL value: 3.14 or -2.71
+
+    Decimal dec;
+    EXPECT_TRUE(row.getDecimal(1, dec));
+    EXPECT_EQ(data_decimal[i] < 0, dec.negative);
+    EXPECT_EQ(2U, dec.scale);
+    EXPECT_EQ(3U, dec.digit_count);
+    EXPECT_EQ(i ? 2 : 3, dec.digits[0]);
+    EXPECT_EQ(i ? 7 : 1, dec.digits[1]);
+    EXPECT_EQ(i ? 1 : 4, dec.digits[2]);
+    EXPECT_THROW(row.getDecimal(0, dec), Error);
   }
 
   cout << "Testing Boolean value" << endl;
@@ -485,6 +497,15 @@ TEST_F(Types, string)
   EXPECT_EQ(str1, (string)row[3]);
   EXPECT_EQ(str1, (string)row[4]);
 
+  // UTF-8 strings can be accessed without conversion.
+
+  std::string utf8_str1("Mog\xC4\x99 je\xC5\x9B\xC4\x87 szk\xC5\x82o");
+
+  bytes data = row.getStringBytes(3);
+  EXPECT_EQ(utf8_str1, std::string((const char*)data.begin(), data.size()));
+  EXPECT_EQ(utf8_str1, row[3].get<std::string>());
+  EXPECT_EQ(utf8_str1, row[4].get<std::string>());
+
   /*
     FIXME: the third colum contains non-utf8 string which uses non-ascii
     characters. Currently we do not handle such strings and an error is
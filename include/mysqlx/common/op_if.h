@@ -44,6 +44,8 @@
 #include "api.h"
 #include "../common_constants.h"
 #include <string>
+#include <functional>
+#include <cstdint>
 
 
 namespace mysqlx {
@@ -104,6 +106,57 @@ struct Executable_if
 };
 
 
+/*
+  Additional interface of executable objects which can be executed
+  asynchronously. It is separate from Executable_if so that layout of that
+  interface is not changed. Implementation is obtained with dynamic_cast<>
+  from Executable_if.
+*/
+
+struct Executable_async_if
+{
+  /*
+    Start sending command(s) of the operation to the server without waiting
+    for the reply. This allows pipelining several operations of the same
+    session. Writing of a command that does not fit into socket buffers
+    is continued by poll() calls. A following execute() call completes
+    the operation.
+  */
+
+  virtual void send() = 0;
+
+  /*
+    Drive execution of the operation without blocking, sending its command
+    first if this was not done yet. Returns true when server reply is
+    available and a following execute() call will not wait for it.
+  */
+
+  virtual bool poll() = 0;
+
+  virtual ~Executable_async_if() {}
+};
+
+
+/*
+  Additional interface of executable objects which allows setting fetch size
+  for the result of a single operation. It is separate from Executable_if for
+  the same reason as Executable_async_if and is obtained the same way.
+*/
+
+struct Executable_fetch_if
+{
+  /*
+    Set the number of rows loaded in one batch when reading the result of
+    the operation. It overrides the FETCH_SIZE option of the session. Value 0
+    means that the session setting is used.
+  */
+
+  virtual void set_fetch_size(uint64_t) = 0;
+
+  virtual ~Executable_fetch_if() {}
+};
+
+
 /*
   The XXX_if classes defined below form a hierarchy of interfaces, based
   on Executable_if, for internal implementations of various crud operations.
@@ -232,6 +285,30 @@ struct Collection_add_if : public Executable_if
 };
 
 
+/*
+  Additional interface of collection add implementations which can read
+  documents from a source. It is separate from Collection_add_if so that
+  layout of that interface is not changed. Implementation is obtained with
+  dynamic_cast<> from Collection_add_if.
+*/
+
+struct Collection_add_source_if
+{
+  /*
+    Set a source of further documents which are read only when the operation
+    is executed, after documents given by add_json(). The source function
+    stores the next document (UTF8 JSON string) in its argument and returns
+    true, or returns false if there are no more documents.
+  */
+
+  using Json_source = std::function<bool(std::string&)>;
+
+  virtual void set_json_source(const Json_source&) = 0;
+
+  virtual ~Collection_add_source_if() {}
+};
+
+
 struct Collection_remove_if : public Select_if<Sort_if>
 {};
 
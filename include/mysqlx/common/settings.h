@@ -127,6 +127,14 @@ public:
 
   static  const char* auth_method_name(Auth_method method);
 
+
+  enum class Compression_mode {
+    COMPRESSION_MODE_LIST(SETTINGS_VAL_ENUM)
+    LAST
+  };
+
+  static  const char* compression_mode_name(Compression_mode mode);
+
 protected:
 
   using Value = common::Value;
@@ -221,6 +229,7 @@ protected:
     bool m_sock = false;  // set to true if socket connection was specified
     bool m_tls_vers = false;
     bool m_tls_ciphers = false;
+    bool m_compr_algs = false;
 
     void erase(int);
     void init_connection_attr();
@@ -282,6 +291,17 @@ const char* Settings_impl::auth_method_name(Auth_method method)
   }
 }
 
+inline
+const char* Settings_impl::compression_mode_name(Compression_mode mode)
+{
+  switch (unsigned(mode))
+  {
+    COMPRESSION_MODE_LIST(SETTINGS_VAL_NAME)
+    default:
+      return nullptr;
+  }
+}
+
 
 /*
   Note: For options that can repeat, returns the last value.
@@ -324,6 +344,11 @@ bool Settings_impl::has_option(int opt) const
       return true;
     break;
 
+  case Session_option_impl::COMPRESSION_ALGORITHMS:
+    if (m_data.m_compr_algs)
+      return true;
+    break;
+
   default:
     break;
   }
@@ -387,6 +412,9 @@ void Settings_impl::Data::erase(int opt)
   case Session_option_impl::CONNECTION_ATTRIBUTES:
     clear_connection_attr();
     break;
+  case Session_option_impl::COMPRESSION_ALGORITHMS:
+    m_compr_algs = false;
+    break;
   default:
     break;
   }
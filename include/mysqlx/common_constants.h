@@ -67,6 +67,8 @@
   the pool (ms). (No timeout by default)*/                                     \
   OPT_NUM(x,POOL_MAX_IDLE_TIME,4)/*!< time for a connection to be in the pool
   without being used (ms).(Will not expire by default)*/                       \
+  OPT_NUM(x,POOL_MIN_SIZE,5) /*!< number of connections kept open in the pool
+  (Defaults to 0)*/                                                            \
   END_LIST
 
 
@@ -133,6 +135,33 @@
     configuration (hostname, port, priority and weight) to connect.
   */                                                                        \
   OPT_BOOL(x, DNS_SRV, 16)                                                  \
+  /*!
+    Number of rows fetched from the server in one batch when reading result
+    rows. If not set (or set to 0) the batch size is adjusted automatically,
+    starting with a small batch and growing it depending on the size of
+    the rows.
+  */                                                                        \
+  OPT_NUM(x, FETCH_SIZE, 17)                                                \
+  /*!
+    Specify \ref CompressionMode to be used. In plain C code the value
+    should be a `#mysqlx_compression_mode_t` enum constant.
+  */                                                                        \
+  OPT_ANY(x, COMPRESSION, 18)                                               \
+  /*!
+    List of compression algorithms to try, in the order of preference, when
+    compression is enabled. The value is a string with comma separated names
+    (currently only "deflate_stream" is supported). In C++ code it can also
+    be an iterable container with names. Unknown algorithms are ignored.
+  */                                                                        \
+  OPT_STR(x, COMPRESSION_ALGORITHMS, 19)                                    \
+  /*!
+    If enabled (true), rows of collection find and table select results are
+    streamed from a server-side cursor: the server sends only as many rows
+    as requested and keeps the rest until the client asks for more. This
+    allows reading large results with bounded memory on both sides, at the
+    cost of additional round-trips. Disabled by default.
+  */                                                                        \
+  OPT_BOOL(x, SERVER_CURSOR, 20)                                            \
   END_LIST
 
 
@@ -153,6 +182,10 @@
   X("connection-attributes",CONNECTION_ATTRIBUTES)\
   X("tls-versions", TLS_VERSIONS) \
   X("tls-ciphersuites", TLS_CIPHERSUITES) \
+  X("fetch-size", FETCH_SIZE) \
+  X("compression", COMPRESSION) \
+  X("compression-algorithms", COMPRESSION_ALGORITHMS) \
+  X("server-cursor", SERVER_CURSOR) \
   END_LIST
 
 
@@ -173,6 +206,17 @@
   END_LIST
 
 
+#define COMPRESSION_MODE_LIST(x) \
+  x(DISABLED,1)        /*!< Messages are not compressed. This is the default
+                          if `COMPRESSION` is not specified. */ \
+  x(PREFERRED,2)       /*!< Compress messages if the server supports one of
+                          the requested compression algorithms. Otherwise
+                          the connection is not compressed. */ \
+  x(REQUIRED,3)        /*!< Like `PREFERRED`, but the connection attempt
+                          fails if compression can not be used. */ \
+  END_LIST
+
+
 #define AUTH_METHOD_LIST(x)\
   x(PLAIN,1)       /*!< Plain text authentication method. The password is
                       sent as a clear text. This method is used by
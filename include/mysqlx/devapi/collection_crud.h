@@ -193,6 +193,41 @@ public:
     CATCH_AND_WRAP
   }
 
+  /**
+    Add all documents from the range [first, last).
+
+    Unlike other variants of `add()`, the documents are not copied when this
+    method is called. Instead they are read from the range when the
+    operation is executed, and sent to the server in chunks of bounded size.
+    This way a large number of documents, for example produced by an input
+    iterator, can be added without keeping all of them in memory. The range
+    must remain valid until the operation is executed and the operation can
+    be executed only once. Documents from the range are added after documents
+    given by other `add()` calls. Only one range can be specified.
+
+    Commands adding consecutive chunks are pipelined, with at most 4 of them
+    waiting for the server reply at any time. The result reports affected
+    rows, generated ids and warnings for all the chunks. If adding one of
+    the chunks fails, the error is reported but documents from the chunks
+    sent before remain in the collection. Also, up to 3 chunks sent after
+    the failed one might have been already added by the server. Execute
+    the operation inside a transaction and roll it back on error to avoid
+    partially added documents.
+
+    Note: Documents given by other variants of `add()` are sent in a single
+    command, unless `addAll()` is used for the same operation.
+  */
+
+  template <typename It>
+  CollectionAdd& addAll(It first, It last)
+  {
+    try {
+      do_add_range(get_impl(), first, last);
+      return *this;
+    }
+    CATCH_AND_WRAP
+  }
+
   /**
     Add document(s) to a collection.
 
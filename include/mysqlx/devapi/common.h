@@ -42,6 +42,7 @@ PUSH_SYS_WARNINGS
 #include <forward_list>
 #include <string.h>  // for memcpy
 #include <utility>   // std::move etc
+#include <tuple>
 POP_SYS_WARNINGS
 
 
@@ -164,6 +164,44 @@ protected:
     Args_prc::process_args(impl, args...);
   }
 
+  static std::string to_json(const string &json)
+  {
+    return json;
+  }
+
+  static std::string to_json(const DbDoc &doc)
+  {
+    std::ostringstream buf;
+    buf << doc;
+    return mysqlx::string(buf.str());
+  }
+
+  /*
+    Documents from the range are converted to JSON strings only when
+    the operation is executed, as they are sent to the server.
+  */
+
+  template <typename It>
+  static void do_add_range(Impl *impl, It first, It last)
+  {
+    auto *src_impl = dynamic_cast<common::Collection_add_source_if*>(impl);
+
+    if (!src_impl)
+    {
+      for (; first != last; ++first)
+        impl->add_json(to_json(*first));
+      return;
+    }
+
+    src_impl->set_json_source([first, last](std::string &json) mutable -> bool {
+      if (first == last)
+        return false;
+      json = to_json(*first);
+      ++first;
+      return true;
+    });
+  }
+
   friend Args_prc;
 };
 
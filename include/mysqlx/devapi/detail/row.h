@@ -47,6 +47,7 @@ namespace mysqlx {
 MYSQLX_ABI_BEGIN(2,0)
 
 class Columns;
+struct Decimal;
 
 namespace internal {
 
@@ -72,6 +73,8 @@ protected:
 
   col_count_t col_count() const;
   bytes       get_bytes(col_count_t) const;
+  bytes       get_utf8(col_count_t) const;
+  bool        get_decimal(col_count_t, Decimal&) const;
   Value&      get_val(col_count_t);
 
   void clear()
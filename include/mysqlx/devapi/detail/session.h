@@ -403,6 +403,22 @@ protected:
   */
   void prepare_for_cmd();
 
+  /*
+    Pipelined execution (see Session::pipeline()).
+  */
+
+  void begin_pipeline();
+  void send_pipeline();
+
+  /*
+    Event loop integration (see Session::getFd()).
+  */
+
+  unsigned get_fd();
+  bool wants_read();
+  bool wants_write();
+  void progress();
+
 public:
 
   /// @cond IGNORED
@@ -58,6 +58,7 @@ class Settings_detail
   using COption     = typename Traits::COptions;
   using SSLMode     = typename Traits::SSLMode;
   using AuthMethod  = typename Traits::AuthMethod;
+  using CompressionMode = typename Traits::CompressionMode;
 
 public:
 
@@ -78,7 +79,8 @@ protected:
 
 #define OPT_VAL_TYPE(X) \
   X(SSL_MODE,SSLMode) \
-  X(AUTH,AuthMethod)
+  X(AUTH,AuthMethod) \
+  X(COMPRESSION,CompressionMode)
 
 #define CHECK_OPT(Opt,Type) \
   if (opt == Session_option_impl::Opt) \
@@ -128,6 +130,16 @@ protected:
     return unsigned(m);
   }
 
+  static Value opt_val(int opt, CompressionMode m)
+  {
+    if (opt != Session_option_impl::COMPRESSION)
+      throw Error(
+        "SessionSettings::CompressionMode value can only be used on"
+        " COMPRESSION setting."
+      );
+    return unsigned(m);
+  }
+
   // Note: is_range<C> is true for string types, which should not be treated
   // as arrays of characters, but as single Values.
 
@@ -48,6 +48,143 @@ MYSQLX_ABI_BEGIN(2,0)
 using std::ostream;
 
 
+namespace internal {
+
+/*
+  Return interface for asynchronous execution of the given operation
+  implementation (see common::Executable_async_if).
+*/
+
+inline
+common::Executable_async_if& async_impl(common::Executable_if *impl)
+{
+  auto *async = dynamic_cast<common::Executable_async_if*>(impl);
+  if (!async)
+    throw Error("Operation can not be executed asynchronously");
+  return *async;
+}
+
+/*
+  Return interface for setting fetch size of the given operation
+  implementation (see common::Executable_fetch_if).
+*/
+
+inline
+common::Executable_fetch_if& fetch_impl(common::Executable_if *impl)
+{
+  auto *fetch = dynamic_cast<common::Executable_fetch_if*>(impl);
+  if (!fetch)
+    throw Error("Fetch size can not be set for this operation");
+  return *fetch;
+}
+
+}  // internal
+
+
+/**
+  Handle to an operation which is executed asynchronously.
+
+  Such handle is returned by `Executable::executeAsync()`. The operation is
+  sent to the server when the handle is created and then its execution is
+  driven by `isReady()` calls which do not block waiting for the server.
+  When `isReady()` returns true, `get()` returns the result of the operation
+  without waiting. Calling `get()` earlier blocks until the reply is received.
+  Errors reported by the server are thrown by `get()`.
+
+  This way a single thread can keep many sessions busy:
+
+  ~~~~~~
+  std::vector<AsyncResult<DocResult>> pending;
+  for (Collection &coll : collections)
+    pending.emplace_back(coll.find("age > 18").executeAsync());
+
+  for (size_t done = 0; done < pending.size();)
+    for (auto &res : pending)
+      if (res.isValid() && res.isReady())
+      {
+        process(res.get());
+        ++done;
+      }
+  ~~~~~~
+
+  @note Operations started on the same session complete in the order in which
+  they were started. Results of such operations must be retrieved with `get()`
+  in that order, otherwise `isReady()` never reports a later one as ready and
+  `get()` for it throws error. Also, other statements can not be executed
+  with `execute()` on that session until results of all pending asynchronous
+  operations are retrieved -- `execute()` throws error in that case.
+
+  @ingroup devapi
+*/
+
+template <class Res>
+class AsyncResult
+{
+  std::unique_ptr<common::Executable_if> m_impl;
+
+  AsyncResult(common::Executable_if *impl)
+    : m_impl(impl)
+  {
+    auto &async = internal::async_impl(m_impl.get());
+    async.send();
+    async.poll();
+  }
+
+  void check_if_valid() const
+  {
+    if (!m_impl)
+      throw Error("Attempt to use invalid asynchronous result");
+  }
+
+public:
+
+  AsyncResult() = default;
+  AsyncResult(AsyncResult&&) = default;
+  AsyncResult& operator=(AsyncResult&&) = default;
+
+  /**
+    Check if this handle refers to an operation whose result was not
+    retrieved with `get()` yet.
+  */
+
+  bool isValid() const
+  {
+    return (bool)m_impl;
+  }
+
+  /**
+    Drive execution of the operation without blocking and return true
+    if server reply is available.
+  */
+
+  bool isReady()
+  {
+    try {
+      check_if_valid();
+      return internal::async_impl(m_impl.get()).poll();
+    }
+    CATCH_AND_WRAP
+  }
+
+  /**
+    Return result of the operation, waiting for it if necessary. After this
+    call the handle becomes invalid.
+  */
+
+  Res get()
+  {
+    try {
+      check_if_valid();
+      std::unique_ptr<common::Executable_if> impl(std::move(m_impl));
+      return impl->execute();
+    }
+    CATCH_AND_WRAP
+  }
+
+  template <class, class> friend class Executable;
+};
+
+
 /**
   Represents an operation that can be executed.
 
@@ -160,11 +297,88 @@ public:
     CATCH_AND_WRAP
   }
 
+  /**
+    Set the number of rows fetched from the server in one batch when
+    reading the result of this operation. It overrides the
+    `SessionOption::FETCH_SIZE` setting of the session for this operation
+    only. Value 0 restores the session setting.
+  */
+
+  Executable& setFetchSize(uint64_t rows)
+  {
+    try {
+      internal::fetch_impl(get_impl()).set_fetch_size(rows);
+      return *this;
+    }
+    CATCH_AND_WRAP
+  }
+
+  /**
+    Start execution of given operation and return a handle which gives
+    access to its result once it is available.
+
+    The operation is executed as it is defined at the time of this call.
+    The executable object can be modified and started again with
+    `executeAsync()` while the asynchronous execution is in progress. But
+    it can not be executed with `execute()` until results of pending
+    asynchronous operations of its session are retrieved.
+
+    @see AsyncResult
+  */
+
+  AsyncResult<Res> executeAsync()
+  {
+    try {
+      check_if_valid();
+      return AsyncResult<Res>(m_impl->clone());
+    }
+    CATCH_AND_WRAP
+  }
+
   struct Access;
   friend Access;
 };
 
 
+/*
+  Access to internals of executable objects needed for pipelined execution
+  (see Session::pipeline()).
+*/
+
+template <class Res, class Op>
+struct Executable<Res, Op>::Access
+{
+  // Send command of the operation to the server without waiting for reply.
+
+  static void send(Executable &exec)
+  {
+    internal::async_impl(exec.get_impl()).send();
+  }
+};
+
+
+namespace internal {
+
+/*
+  Exec_result<Op> is the type of result returned by executable object
+  of type Op.
+*/
+
+template <class Res, class Op>
+Res exec_result(Executable<Res, Op>&);
+
+template <class Op>
+using Exec_result = decltype(exec_result(std::declval<Op&>()));
+
+template <class Res, class Op>
+void exec_send(Executable<Res, Op> &exec)
+{
+  Executable<Res, Op>::Access::send(exec);
+}
+
+}  // internal
+
+
 MYSQLX_ABI_END(2,0)
 }  // mysqlx
 
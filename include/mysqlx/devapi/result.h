@@ -215,6 +215,8 @@ private:
 
   template <class Res, class Op>
   friend class Executable;
+  template <class Res>
+  friend class AsyncResult;
   friend Collection;
 };
 
@@ -650,6 +652,7 @@ private:
 public:
 
   template <class Res, class Op> friend class Executable;
+  template <class Res> friend class AsyncResult;
   friend SqlResult;
   friend DocResult;
 };
@@ -730,6 +733,8 @@ private:
 
   template <class Res, class Op>
   friend class Executable;
+  template <class Res>
+  friend class AsyncResult;
 };
 
 
@@ -836,6 +841,8 @@ private:
   friend DbDoc;
   template <class Res, class Op>
   friend class Executable;
+  template <class Res>
+  friend class AsyncResult;
 };
 
 MYSQLX_ABI_END(2,0)
@@ -48,6 +48,28 @@ namespace mysqlx {
 MYSQLX_ABI_BEGIN(2,0)
 
 
+/**
+  Exact value of a DECIMAL field, as returned by `Row::getDecimal()`.
+
+  The value is given by `digit_count` decimal digits stored in `digits`
+  array, most significant first, of which the last `scale` ones are after
+  the decimal point. For example, -12.50 is represented with `negative` set
+  to true, digits 1, 2, 5, 0 and scale 2.
+
+  @ingroup devapi_res
+*/
+
+struct Decimal
+{
+  static const unsigned max_digits = 65;
+
+  bool          negative = false;
+  unsigned      scale = 0;
+  unsigned      digit_count = 0;
+  unsigned char digits[max_digits];
+};
+
+
 /**
   Represents a single row from a result that contains rows.
 
@@ -117,6 +139,48 @@ public:
   }
 
 
+  /**
+    Get UTF-8 encoding of a string field at position `pos`.
+
+    Unlike `get()`, this does not convert or copy the string. The returned
+    bytes refer to the row data and remain valid as long as this row
+    object exists.
+
+    @returns null bytes range if given field is NULL.
+    @throws Error if given field does not hold a UTF-8 string.
+    @throws out_of_range if given row was not fetched from server.
+  */
+
+  bytes getStringBytes(col_count_t pos) const
+  {
+    try {
+      return Row_detail::get_utf8(pos);
+    }
+    CATCH_AND_WRAP
+  }
+
+
+  /**
+    Get exact value of a DECIMAL field at position `pos`.
+
+    Unlike `get()`, which converts DECIMAL values to double, this gives all
+    digits of the value without loss of precision.
+
+    @returns false if given field is NULL, in which case `val` is not
+    modified.
+    @throws Error if given field does not hold a DECIMAL value.
+    @throws out_of_range if given row was not fetched from server.
+  */
+
+  bool getDecimal(col_count_t pos, Decimal &val) const
+  {
+    try {
+      return Row_detail::get_decimal(pos, val);
+    }
+    CATCH_AND_WRAP
+  }
+
+
   /**
     Get reference to row field at position `pos`.
 
@@ -282,6 +282,41 @@ std::string AuthMethodName(AuthMethod m)
 /// @endcond
 
 
+/**
+  Modes to be used with `COMPRESSION` option.
+  \anchor CompressionMode
+*/
+
+enum_class CompressionMode
+{
+#define COMPRESSION_ENUM(X,N) X=N,
+
+  COMPRESSION_MODE_LIST(COMPRESSION_ENUM)
+};
+
+
+/// @cond DISABLED
+
+inline
+std::string CompressionModeName(CompressionMode m)
+{
+#define COMPRESSION_NAME(X,N) case CompressionMode::X: return #X;
+
+  switch (m)
+  {
+    COMPRESSION_MODE_LIST(COMPRESSION_NAME)
+  default:
+    {
+      std::ostringstream buf;
+      buf << "<UKNOWN (" << unsigned(m) << ")>" << std::ends;
+      return buf.str();
+    }
+  };
+}
+
+/// @endcond
+
+
 namespace internal {
 
 
@@ -296,6 +331,7 @@ struct Settings_traits
   using COptions   = mysqlx::ClientOption;
   using SSLMode    = mysqlx::SSLMode;
   using AuthMethod = mysqlx::AuthMethod;
+  using CompressionMode = mysqlx::CompressionMode;
 
   static std::string get_mode_name(SSLMode mode)
   {
@@ -311,6 +347,11 @@ struct Settings_traits
   {
     return AuthMethodName(m);
   }
+
+  static std::string get_compression_name(CompressionMode m)
+  {
+    return CompressionModeName(m);
+  }
 };
 
 
@@ -480,6 +521,13 @@ public:
         the same as setting to `true`\n
     - `tls-versions=[...]` : see `SessionOption::TLS_VERSIONS`
     - `tls-ciphersuites=[...]` : see `SessionOption::TLS_CIPHERSUITES`
+    - `fetch-size=...` : see `SessionOption::FETCH_SIZE`
+    - `compression=...` : see `SessionOption::COMPRESSION`; the value is
+        a case insensitive name of the compression mode
+    - `compression-algorithms=[...]` : see
+        `SessionOption::COMPRESSION_ALGORITHMS`
+    - `server-cursor=...` : see `SessionOption::SERVER_CURSOR`; the value
+        is `true` or `false`
   */
 
   SessionSettings(const string &uri)
@@ -860,6 +908,10 @@ public:
                      an available session will wait in the pool before it is
                      removed.
                      By default it doesn't cleans sessions.
+    - `minSize` : integer that defines the number of sessions which are kept
+                  open in the pool, even if not used. They are created in the
+                  background and are not removed after `maxIdleTime`.
+                  Defaults to 0.
 
   */
 
@@ -904,6 +956,10 @@ public:
                      an available session will wait in the pool before it is
                      removed.
                      By default it doesn't cleans sessions.
+    - `minSize` : integer that defines the number of sessions which are kept
+                  open in the pool, even if not used. They are created in the
+                  background and are not removed after `maxIdleTime`.
+                  Defaults to 0.
 
   */
 
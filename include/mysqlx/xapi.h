@@ -372,6 +372,7 @@ mysqlx_client_opt_type_t;
 #define OPT_POOL_MAX_SIZE(A) MYSQLX_CLIENT_OPT_POOL_MAX_SIZE, (uint64_t)(A)
 #define OPT_POOL_QUEUE_TIMEOUT(A) MYSQLX_CLIENT_OPT_POOL_QUEUE_TIMEOUT, (uint64_t)(A)
 #define OPT_POOL_MAX_IDLE_TIME(A) MYSQLX_CLIENT_OPT_POOL_MAX_IDLE_TIME, (uint64_t)(A)
+#define OPT_POOL_MIN_SIZE(A) MYSQLX_CLIENT_OPT_POOL_MIN_SIZE, (uint64_t)(A)
 
 /**
   Session options for use with `mysqlx_session_option_get()`
@@ -415,6 +416,10 @@ mysqlx_opt_type_t;
 #define OPT_CONNECTION_ATTRIBUTES(A) MYSQLX_OPT_CONNECTION_ATTRIBUTES, (A)
 #define OPT_TLS_VERSIONS(A) MYSQLX_OPT_TLS_VERSIONS, (A)
 #define OPT_TLS_CIPHERSUITES(A) MYSQLX_OPT_TLS_CIPHERSUITES, (A)
+#define OPT_FETCH_SIZE(A) MYSQLX_OPT_FETCH_SIZE, (unsigned int)(A)
+#define OPT_COMPRESSION(A) MYSQLX_OPT_COMPRESSION, (unsigned int)(A)
+#define OPT_COMPRESSION_ALGORITHMS(A) MYSQLX_OPT_COMPRESSION_ALGORITHMS, (A)
+#define OPT_SERVER_CURSOR(A) MYSQLX_OPT_SERVER_CURSOR, (unsigned int)(A)
 
 
 /**
@@ -445,6 +450,20 @@ typedef enum mysqlx_auth_method_enum
 }
 mysqlx_auth_method_t;
 
+/**
+  Compression mode values for use with `mysqlx_session_option_get()`
+  and `mysqlx_session_option_set()` functions setting or getting
+  MYSQLX_OPT_COMPRESSION option.
+*/
+
+typedef enum mysqlx_compression_mode_enum
+{
+#define XAPI_COMPRESSION_ENUM(X,N)  MYSQLX_COMPRESSION_##X = N,
+
+  COMPRESSION_MODE_LIST(XAPI_COMPRESSION_ENUM)
+}
+mysqlx_compression_mode_t;
+
 
 /**
   Constants for defining the row locking options for
@@ -522,6 +541,10 @@ mysqlx_lock_contention_t;
                     an available session will wait in the pool before it is
                     removed.
                     By default it doesn't cleans sessions.
+  - `minSize` : integer that defines the number of sessions which are kept
+                open in the pool, even if not used. They are created in the
+                background and are not removed after `maxIdleTime`.
+                Defaults to 0.
 
   @param conn_string    connection string
   @param client_opts    client options in the form of a JSON string.
@@ -576,6 +599,10 @@ mysqlx_get_client_from_url(const char *conn_string, const char *client_opts,
                     an available session will wait in the pool before it is
                     removed.
                     By default it doesn't cleans sessions.
+  - `minSize` : integer that defines the number of sessions which are kept
+                open in the pool, even if not used. They are created in the
+                background and are not removed after `maxIdleTime`.
+                Defaults to 0.
 
   @param opt  handle to client configuration data
   @param[out] error     if error happens during connect the error object
@@ -737,6 +764,12 @@ mysqlx_get_session(const char *host, int port, const char *user,
       the same as setting to `true`\n
   - `tls-versions=[...]` : see `#MYSQLX_OPT_TLS_VERSIONS`
   - `tls-ciphersuites=[...]` : see `#MYSQLX_OPT_TLS_CIPHERSUITES`
+  - `fetch-size=...` : see `#MYSQLX_OPT_FETCH_SIZE`
+  - `compression=...` : see `#MYSQLX_OPT_COMPRESSION`; the value is a case
+      insensitive name of the compression mode
+  - `compression-algorithms=[...]` : see `#MYSQLX_OPT_COMPRESSION_ALGORITHMS`
+  - `server-cursor=...` : see `#MYSQLX_OPT_SERVER_CURSOR`; the value is
+      `true` or `false`
 
 
   @note The session returned by the function must be properly closed using
@@ -813,6 +846,72 @@ PUBLIC_API void mysqlx_session_close(mysqlx_session_t *session);
 
 PUBLIC_API int mysqlx_session_valid(mysqlx_session_t *sess);
 
+
+/**
+  Flags returned by `mysqlx_session_io_interest()`.
+
+  @ingroup xapi_sess
+*/
+
+#define MYSQLX_WANT_READ  1
+#define MYSQLX_WANT_WRITE 2
+
+
+/**
+  Get native descriptor of the socket used by the session.
+
+  Together with `mysqlx_session_io_interest()` and `mysqlx_session_progress()`
+  this allows driving the session from an external event loop.
+
+  @param sess    session handle
+  @param[out] fd the socket descriptor is returned through this parameter
+
+  @return `RESULT_OK` - on success; `RESULT_ERROR` - on error. The error
+          can be examined using the session handle.
+
+  @ingroup xapi_sess
+*/
+
+PUBLIC_API int
+mysqlx_session_get_fd(mysqlx_session_t *sess, unsigned int *fd);
+
+
+/**
+  Get the I/O events that pending operations of the session wait for.
+
+  The event loop should watch the session socket for these events and call
+  `mysqlx_session_progress()` when it is ready. The interest set should be
+  checked again after each `mysqlx_session_progress()` call.
+
+  @param sess session handle
+
+  @return combination of `MYSQLX_WANT_READ` and `MYSQLX_WANT_WRITE` flags,
+          0 if no I/O is needed or `RESULT_ERROR` on error
+
+  @ingroup xapi_sess
+*/
+
+PUBLIC_API int
+mysqlx_session_io_interest(mysqlx_session_t *sess);
+
+
+/**
+  Drive pending operations of the session without blocking.
+
+  Errors reported by the server are not returned by this function but by
+  the operations to which they belong.
+
+  @param sess session handle
+
+  @return `RESULT_OK` - on success; `RESULT_ERROR` - on error. The error
+          can be examined using the session handle.
+
+  @ingroup xapi_sess
+*/
+
+PUBLIC_API int
+mysqlx_session_progress(mysqlx_session_t *sess);
+
 /**
   Get a list of schemas.
 
@@ -2293,6 +2392,35 @@ PUBLIC_API mysqlx_result_t *
 mysqlx_execute(mysqlx_stmt_t *stmt);
 
 
+/**
+  Execute several statements in a pipeline
+
+  Commands of all the statements, which must belong to the same session,
+  are sent to the server together in a single write, without waiting for
+  server replies in between. Then the replies are processed in the order
+  of statements. This saves round-trips when several independent statements
+  are executed one after another.
+
+  @param stmts   array of statement handles
+  @param count   number of statements in the array
+  @param results array of `count` elements in which the result handles of
+                 the statements are stored (as returned by
+                 `mysqlx_execute()`). If a statement fails, NULL is stored
+                 and errors can be examined using the statement handle.
+
+  @return `RESULT_OK` if all statements were executed successfully,
+          `RESULT_ERROR` otherwise. Note that a failure of one statement
+          does not prevent execution of the following ones, as their
+          commands were already sent to the server.
+
+  @ingroup xapi_stmt
+*/
+
+PUBLIC_API int
+mysqlx_execute_pipeline(mysqlx_stmt_t *stmts[], size_t count,
+                        mysqlx_result_t *results[]);
+
+
 /**
   Bind values for parametrized statements.
 
@@ -2525,6 +2653,24 @@ PUBLIC_API int
 mysqlx_set_limit_and_offset(mysqlx_stmt_t *stmt, uint64_t row_count,
                             uint64_t offset);
 
+/**
+  Set fetch size for the result of a statement.
+
+  Rows of the result are loaded from the server in batches of the given
+  size. This overrides `#MYSQLX_OPT_FETCH_SIZE` option of the session
+  for this statement only. Value 0 restores the session setting.
+
+  @param stmt statement handle
+  @param row_count the number of rows fetched in one batch
+
+  @return `RESULT_OK` - on success; `RESULT_ERR` - on error
+
+  @ingroup xapi_stmt
+*/
+
+PUBLIC_API int
+mysqlx_set_fetch_size(mysqlx_stmt_t *stmt, uint64_t row_count);
+
 /**
   Set row locking mode for a statement.
 
@@ -2878,6 +3024,49 @@ PUBLIC_API int
 mysqlx_get_double(mysqlx_row_t* row, uint32_t col, double *val);
 
 
+#define MYSQLX_DECIMAL_MAX_DIGITS 65
+
+/**
+  Exact value of a DECIMAL column, as returned by `mysqlx_get_decimal()`.
+
+  The value is given by `digit_count` decimal digits stored in `digits`
+  array, most significant first, of which the last `scale` ones are after
+  the decimal point. For example, -12.50 is represented with `negative` set
+  to 1, digits 1, 2, 5, 0 and scale 2.
+
+  @ingroup xapi_res
+*/
+
+typedef struct mysqlx_decimal_struct
+{
+  int      negative;
+  uint8_t  scale;
+  uint8_t  digit_count;
+  uint8_t  digits[MYSQLX_DECIMAL_MAX_DIGITS];
+} mysqlx_decimal_t;
+
+
+/**
+  Get exact value of a DECIMAL column from a row.
+
+  Unlike `mysqlx_get_double()`, this function does not lose precision.
+  Calling it for a column whose type is not `MYSQLX_TYPE_DECIMAL` is
+  an error.
+
+  @param row row handle
+  @param col zero-based column number
+  @param[out] val the pointer to a structure in which to write the value
+
+  @return `RESULT_OK` - on success; `RESULT_NULL` when the column is NULL;
+          `RESULT_ERR` - on error
+
+  @ingroup xapi_res
+*/
+
+PUBLIC_API int
+mysqlx_get_decimal(mysqlx_row_t* row, uint32_t col, mysqlx_decimal_t *val);
+
+
 /**
   Free the result explicitly.
 
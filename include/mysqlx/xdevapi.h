@@ -1387,6 +1387,142 @@ public:
   }
 
 
+  /**
+    Execute given operations in a pipeline.
+
+    Commands of all the operations are sent to the server together, in
+    a single write, without waiting for server replies in between. Then
+    the replies are processed in order. This saves round-trips when several
+    independent operations are executed one after another.
+
+    Returns a tuple with results of the operations, in the same order.
+    Operations must belong to this session. Each operation object can be
+    executed only once in a pipeline.
+
+    Example:
+    ~~~~~~
+      auto res = sess.pipeline(
+        coll.add(doc),
+        coll.modify("name = 'foo'").set("age", 2),
+        sess.sql("UPDATE t SET c = c + 1")
+      );
+      Result add_res = std::move(std::get<0>(res));
+    ~~~~~~
+
+    @note If one of the operations fails, the error is thrown when its
+    reply is processed. Operations following it in the pipeline were already
+    sent and are executed by the server regardless.
+  */
+
+  template <typename... Ops>
+  std::tuple<internal::Exec_result<Ops>...> pipeline(Ops&&... ops)
+  {
+    try {
+      Session_detail::begin_pipeline();
+
+      try {
+        int unused[] = { 0, (internal::exec_send(ops), 0)... };
+        (void)unused;
+      }
+      catch (...)
+      {
+        Session_detail::send_pipeline();
+        throw;
+      }
+
+      Session_detail::send_pipeline();
+
+      // Note: elements of braced initializer list are evaluated in order.
+
+      return std::tuple<internal::Exec_result<Ops>...>{ ops.execute()... };
+    }
+    CATCH_AND_WRAP
+  }
+
+
+  /**
+    @name Event loop integration
+
+    Operations started with `executeAsync()` can be driven from an external
+    event loop. The loop watches the socket returned by `getFd()` for the
+    events reported by `wantsRead()` and `wantsWrite()`. When the socket is
+    ready, `progress()` is called to move pending operations forward. It never
+    waits for I/O. The interest set should be checked again after each
+    `progress()` call.
+
+    Example:
+    ~~~~~~
+      auto res = coll.find("age > 18").executeAsync();
+      while (!res.isReady())
+      {
+        sess.progress();
+        // register sess.getFd() with the event loop for reading if
+        // sess.wantsRead(), for writing if sess.wantsWrite()
+        // and wait for events
+      }
+    ~~~~~~
+
+    @note Rows of a result set are read from the socket when they are
+    fetched from the result object.
+  */
+  ///@{
+
+  /**
+    Return native descriptor of the socket used by this session.
+  */
+
+  unsigned getFd()
+  {
+    try {
+      return Session_detail::get_fd();
+    }
+    CATCH_AND_WRAP
+  }
+
+  /**
+    Return true if pending operations wait for the socket to become
+    readable.
+  */
+
+  bool wantsRead()
+  {
+    try {
+      return Session_detail::wants_read();
+    }
+    CATCH_AND_WRAP
+  }
+
+  /**
+    Return true if pending operations wait for the socket to become
+    writable.
+  */
+
+  bool wantsWrite()
+  {
+    try {
+      return Session_detail::wants_write();
+    }
+    CATCH_AND_WRAP
+  }
+
+  /**
+    Drive pending operations of this session without blocking.
+
+    Errors reported by the server are not thrown here but by the operations
+    to which they belong.
+  */
+
+  void progress()
+  {
+    try {
+      Session_detail::progress();
+    }
+    CATCH_AND_WRAP
+  }
+
+  ///@}
+
+
   /**
     Close this session.
 
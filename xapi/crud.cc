@@ -552,6 +552,27 @@ int mysqlx_stmt_struct::set_limit(cdk::row_count_t row_count, cdk::row_count_t o
 }
 
 
+/*
+  Set fetch size for the result of the operation
+  PARAMETERS:
+    row_count - the number of rows fetched in one batch, 0 to use session's
+                fetch size
+
+  RETURN:
+    RESULT_OK - on success
+    RESULT_ERROR - on error
+*/
+int mysqlx_stmt_struct::set_fetch_size(cdk::row_count_t row_count)
+{
+  auto *impl = dynamic_cast<Executable_fetch_if*>(m_impl.get());
+  if (!impl)
+    throw Mysqlx_exception(MYSQLX_ERROR_OP_NOT_SUPPORTED);
+
+  impl->set_fetch_size(row_count);
+  return RESULT_OK;
+}
+
+
 /*
   Set one item in ORDER BY for CRUD operation
   PARAMETERS:
@@ -179,6 +179,7 @@ public:
 
   int set_where(const char *where_expr);
   int set_limit(cdk::row_count_t row_count, cdk::row_count_t offset);
+  int set_fetch_size(cdk::row_count_t row_count);
   int set_having(const char *having_expr);
 
   int add_order_by(va_list &args);
@@ -517,6 +517,15 @@ mysqlx_set_limit_and_offset(mysqlx_stmt_struct *stmt, uint64_t row_count,
 }
 
 
+int STDCALL
+mysqlx_set_fetch_size(mysqlx_stmt_struct *stmt, uint64_t row_count)
+{
+  SAFE_EXCEPTION_BEGIN(stmt, RESULT_ERROR)
+  return stmt->set_fetch_size(row_count);
+  SAFE_EXCEPTION_END(stmt, RESULT_ERROR)
+}
+
+
 int mysqlx_set_row_locking(mysqlx_stmt_t *stmt, int locking, int contention)
 {
   SAFE_EXCEPTION_BEGIN(stmt, RESULT_ERROR)
@@ -634,6 +643,70 @@ mysqlx_result_struct * STDCALL mysqlx_execute(mysqlx_stmt_struct *stmt)
 }
 
 
+int STDCALL
+mysqlx_execute_pipeline(mysqlx_stmt_struct *stmts[], size_t count,
+                        mysqlx_result_struct *results[])
+{
+  if (!stmts || !results || 0 == count)
+    return RESULT_ERROR;
+
+  mysqlx_stmt_struct *first = stmts[0];
+
+  SAFE_EXCEPTION_BEGIN(first, RESULT_ERROR)
+
+  mysqlx_session_struct &sess = first->get_session();
+
+  for (size_t i = 0; i < count; ++i)
+  {
+    results[i] = NULL;
+    if (!stmts[i] || &stmts[i]->get_session() != &sess)
+      throw Mysqlx_exception("Pipelined statements must belong to the same"
+                             " session");
+  }
+
+  if (!sess.is_valid())
+    return RESULT_ERROR;
+
+  Session_impl &impl = sess.get_impl();
+
+  impl.begin_pipeline();
+
+  try {
+    for (size_t i = 0; i < count; ++i)
+    {
+      if (stmts[i]->get_error())
+        continue;
+
+      auto *impl
+        = dynamic_cast<common::Executable_async_if*>(stmts[i]->m_impl.get());
+      if (!impl)
+        throw Mysqlx_exception("Statement can not be pipelined");
+      impl->send();
+    }
+  }
+  catch (...)
+  {
+    impl.send_pipeline();
+    throw;
+  }
+
+  impl.send_pipeline();
+
+  int rc = RESULT_OK;
+
+  for (size_t i = 0; i < count; ++i)
+  {
+    results[i] = mysqlx_execute(stmts[i]);
+    if (!results[i])
+      rc = RESULT_ERROR;
+  }
+
+  return rc;
+
+  SAFE_EXCEPTION_END(first, RESULT_ERROR)
+}
+
+
 int STDCALL mysqlx_set_update_values(mysqlx_stmt_struct *stmt, ...)
 {
   SAFE_EXCEPTION_BEGIN(stmt, RESULT_ERROR)
@@ -956,6 +1029,28 @@ int STDCALL mysqlx_get_double(mysqlx_row_struct* row, uint32_t col, double *val)
 }
 
 
+int STDCALL mysqlx_get_decimal(mysqlx_row_struct* row, uint32_t col,
+                               mysqlx_decimal_t *val)
+{
+  SAFE_EXCEPTION_BEGIN(row, RESULT_ERROR)
+  OUT_BUF_CHECK(val, row, MYSQLX_ERROR_OUTPUT_BUFFER_NULL, RESULT_ERROR)
+  CHECK_COLUMN_RANGE(col, row)
+
+  cdk::Decimal dec;
+
+  if (!row->get_decimal(col, dec))
+    return RESULT_NULL;
+
+  val->negative = dec.negative ? 1 : 0;
+  val->scale = dec.scale;
+  val->digit_count = dec.digit_count;
+  memcpy(val->digits, dec.digits, dec.digit_count);
+  return RESULT_OK;
+
+  SAFE_EXCEPTION_END(row, RESULT_ERROR)
+}
+
+
 /*
   Get the number of columns in the result
   PARAMETERS:
@@ -1812,6 +1907,42 @@ mysqlx_session_valid(mysqlx_session_struct *sess)
 }
 
 
+int STDCALL
+mysqlx_session_get_fd(mysqlx_session_struct *sess, unsigned int *fd)
+{
+  SAFE_EXCEPTION_BEGIN(sess, RESULT_ERROR)
+  PARAM_NULL_CHECK(fd, sess, MYSQLX_ERROR_OUTPUT_VARIABLE_NULL, RESULT_ERROR);
+  *fd = sess->get_impl().get_fd();
+  return RESULT_OK;
+  SAFE_EXCEPTION_END(sess, RESULT_ERROR)
+}
+
+
+int STDCALL
+mysqlx_session_io_interest(mysqlx_session_struct *sess)
+{
+  SAFE_EXCEPTION_BEGIN(sess, RESULT_ERROR)
+  Session_impl &impl = sess->get_impl();
+  int flags = 0;
+  if (impl.wants_read())
+    flags |= MYSQLX_WANT_READ;
+  if (impl.wants_write())
+    flags |= MYSQLX_WANT_WRITE;
+  return flags;
+  SAFE_EXCEPTION_END(sess, RESULT_ERROR)
+}
+
+
+int STDCALL
+mysqlx_session_progress(mysqlx_session_struct *sess)
+{
+  SAFE_EXCEPTION_BEGIN(sess, RESULT_ERROR)
+  sess->get_impl().progress();
+  return RESULT_OK;
+  SAFE_EXCEPTION_END(sess, RESULT_ERROR)
+}
+
+
 mysqlx_session_options_t * STDCALL
 mysqlx_session_options_new()
 {
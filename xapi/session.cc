@@ -52,6 +52,7 @@ mysqlx_session_struct::mysqlx_session_struct(
   cdk::ds::Multi_source ds;
   opt->get_data_source(ds);
   m_impl = std::make_shared<Session_impl>(ds);
+  m_impl->set_options(*opt);
 }
 
 
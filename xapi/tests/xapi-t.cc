@@ -287,6 +287,67 @@ TEST_F(xapi, store_result_select)
 
 }
 
+TEST_F(xapi, pipeline)
+{
+  SKIP_IF_NO_XPLUGIN
+
+  mysqlx_stmt_t *stmts[3];
+  mysqlx_result_t *results[3];
+  mysqlx_row_t *row;
+  int64_t val = 0;
+
+  AUTHENTICATE();
+
+  const char *queries[] = {
+    "SELECT 1", "SELECT * FROM no_such_table", "SELECT 3"
+  };
+
+  for (unsigned i = 0; i < 3; ++i)
+  {
+    RESULT_CHECK(stmts[i] = mysqlx_sql_new(get_session(), queries[i],
+                                           strlen(queries[i])));
+  }
+
+  // Error in the second statement does not affect other ones.
+
+  EXPECT_EQ(RESULT_ERROR, mysqlx_execute_pipeline(stmts, 3, results));
+
+  ASSERT_TRUE(results[0] != NULL);
+  EXPECT_TRUE(results[1] == NULL);
+  EXPECT_TRUE(mysqlx_error(stmts[1]) != NULL);
+  ASSERT_TRUE(results[2] != NULL);
+
+  EXPECT_TRUE((row = mysqlx_row_fetch_one(results[0])) != NULL);
+  EXPECT_EQ(RESULT_OK, mysqlx_get_sint(row, 0, &val));
+  EXPECT_EQ(1, val);
+
+  EXPECT_TRUE((row = mysqlx_row_fetch_one(results[2])) != NULL);
+  EXPECT_EQ(RESULT_OK, mysqlx_get_sint(row, 0, &val));
+  EXPECT_EQ(3, val);
+}
+
+TEST_F(xapi, event_loop)
+{
+  SKIP_IF_NO_XPLUGIN
+
+  unsigned int fd = 0;
+
+  AUTHENTICATE();
+
+  EXPECT_EQ(RESULT_OK, mysqlx_session_get_fd(get_session(), &fd));
+  EXPECT_EQ(RESULT_ERROR, mysqlx_session_get_fd(get_session(), NULL));
+
+  // Note: Session uses TLS by default, descriptor of the underlying
+  // connection must be returned also in that case.
+
+  EXPECT_NE(UINT_MAX, fd);
+
+  EXPECT_EQ(RESULT_OK, mysqlx_session_progress(get_session()));
+
+  int interest = mysqlx_session_io_interest(get_session());
+  EXPECT_EQ(0, interest & ~(MYSQLX_WANT_READ | MYSQLX_WANT_WRITE));
+}
+
 TEST_F(xapi, store_result_find)
 {
   SKIP_IF_NO_XPLUGIN
@@ -2996,9 +2996,21 @@ TEST_F(xapi, test_decimal_type)
     switch (row_num)
     {
     case 1:
+    {
       EXPECT_TRUE(f == -786.9876543219F);
       EXPECT_TRUE(d > -786.987654322L && d < -786.987654321L);
+
+      mysqlx_decimal_t dec;
+      const char *digits = "7869876543219";
+      EXPECT_EQ(RESULT_OK, mysqlx_get_decimal(row, 1, &dec));
+      EXPECT_EQ(1, dec.negative);
+      EXPECT_EQ(10, dec.scale);
+      EXPECT_EQ(strlen(digits), dec.digit_count);
+      for (unsigned i = 0; i < dec.digit_count; ++i)
+        EXPECT_EQ(digits[i] - '0', dec.digits[i]);
+      EXPECT_EQ(RESULT_ERROR, mysqlx_get_decimal(row, 0, &dec));
       break;
+    }
     case 2:
       EXPECT_TRUE(f == 10.000001234F);
       EXPECT_TRUE(d > 10.000001230L && d < 10.000001240L);